@@ -0,0 +1,74 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "axisym.h"
+
+typedef const double creal;
+typedef double real;
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION (reference phase where f(r,z) < 0):                            *
+ * circle in the r-z plane of an axisymmetric domain, a torus if its center  *
+ * is off the axis, a sphere if it is on the axis                             *
+ * f(r,z) = (r - rc)^2 + (z - zc)^2 - a^2                                     *
+ * PARAMETERS (userdata):                                                     *
+ * (rc,zc): center of the circle; a: its radius                               *
+ * -------------------------------------------------------------------------- */
+
+real impl_func(void *userdata,creal xy[])
+{
+  real *par = (real *) userdata;
+
+  return (xy[0] - par[0])*(xy[0] - par[0]) + (xy[1] - par[1])*(xy[1] - par[1]) - 
+         par[2]*par[2];
+}
+
+/* -------------------------------------------------------------------------- */
+
+real check_volume(creal vol_n,void *userdata)
+{
+  real *par = (real *) userdata;
+  real vol_a;
+  
+  if (par[0] > 0.)
+    vol_a = 2.*M_PI*M_PI*par[0]*par[2]*par[2];                       /* torus */
+  else
+    vol_a = 4.*M_PI*par[2]*par[2]*par[2]/3.;                        /* sphere */
+  
+  fprintf (stdout,"--------------------------------------------------------------------\n");
+  fprintf (stdout,"--------------------- C: axisymmetric check ------------------------\n");
+  fprintf (stdout," * circle in the r-z plane [%.1f,%.1f]x[%.1f,%.1f] in a %dX%d grid   *\n", R0, R0+H, Z0, Z0+H, NMR, NMZ);
+  fprintf (stdout," * f(r,z) = (r - rc)^2 + (z - zc)^2 - a^2                          *\n");
+  fprintf (stdout," * PARAMETERS:                                                     *\n");
+  fprintf (stdout," * (rc,zc): center of the circle; a: its radius                    *\n");
+  fprintf (stdout,"--------------------------------------------------------------------\n");
+  fprintf (stdout,"rc:    %23.16e\n",par[0]);
+  fprintf (stdout,"zc:    %23.16e\n",par[1]);
+  fprintf (stdout,"a:     %23.16e\n",par[2]);
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"analytical volume: %23.16e\n",vol_a);
+  fprintf (stdout,"numerical  volume: %23.16e\n\n",vol_n);
+  fprintf (stdout,"absolute error   : %23.16e\n",fabs(vol_a-vol_n));
+  fprintf (stdout,"relative error   : %23.16e\n",fabs(vol_a-vol_n)/vol_a);
+  fprintf (stdout,"-------------- C: end axisymmetric check ------------------\n");
+  fprintf (stdout,"-----------------------------------------------------------\n\n");
+
+  return fabs(vol_a-vol_n)/vol_a;
+}
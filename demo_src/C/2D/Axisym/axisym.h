@@ -0,0 +1,35 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/* grid resolution */
+#define NMR   32
+#define NMZ   32
+
+/* computational box, r = x along the first direction */
+#define R0  0.0
+#define Z0  0.0
+#define  H  1.0
+
+/* torus: circle of radius AT with center (RT,ZT) in the r-z plane */
+#define  AT  0.21
+#define  RT  0.5
+#define  ZT  0.47
+
+/* sphere: circle of radius AS with center (0,ZS) on the axis */
+#define  AS  0.3
+#define  ZS  0.52
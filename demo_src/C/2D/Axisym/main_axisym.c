@@ -0,0 +1,83 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "vofi.h"
+#include "axisym.h"
+
+#define NDIM  3
+#define N2D   2
+#define IRAD  0
+#define TOLA  1.0e-12
+
+extern vofi_real check_volume(vofi_creal,void *);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE AXISYMMETRIC VOLUME FRACTION OF A TORUS AND OF A      *
+ * SPHERE IN THE R-Z PLANE: THE SUM OF 2*PI*R*H^2*CC OVER THE CELLS, WITH THE *
+ * RADIUS R OF THE CELL CENTER, MUST BE THE EXACT VOLUME                      *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint ndim0=N2D;
+  int i,j,n,itrue,nerr;
+  vofi_real par[2][3] = {{RT,ZT,AT},{0.,ZS,AS}};
+  vofi_real x0[NDIM],xloc[NDIM];
+  double h0,fh,cc,vol_n,err;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the axisymmetric color function of the two shapes       * 
+ * -------------------------------------------------------------------------- */
+  
+  h0 = H/NMR;                                                 /* grid spacing */
+  itrue = 1;
+  nerr = 0;
+
+  for (n=0;n<2;n++) {
+    /* starting point to get fh */
+    x0[0] = par[n][0] + 0.5*par[n][2];
+    x0[1] = par[n][1];
+    x0[2] = 0.;
+    fh = vofi_Get_fh(impl_func,par[n],x0,h0,ndim0,itrue);
+
+    /* put now starting point in (R0,Z0) */
+    x0[0] = R0; 
+    x0[1] = Z0; 
+
+    vol_n = 0.;
+    xloc[2] = 0.;
+    for (j=0;j<NMZ;j++)
+      for (i=0;i<NMR;i++) {
+	xloc[0] = x0[0] + i*h0;
+	xloc[1] = x0[1] + j*h0;
+	cc = vofi_Get_cc_axi(impl_func,par[n],xloc,h0,fh,IRAD);
+	if (cc < 0. || cc > 1.)
+	  nerr++;
+	vol_n += 2.*M_PI*(xloc[0] + 0.5*h0)*h0*h0*cc;
+      }
+
+    err = check_volume(vol_n,par[n]);
+    if (err > TOLA)
+      nerr++;
+  }
+
+  return (nerr == 0) ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bubbles.h"
+
+typedef const double creal;
+typedef const int cint;
+typedef double real;
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION (reference phase where f(x,y,z) < 0):                          *
+ * two separate spherical bubbles inside the cube [0,1]x[0,1]x[0,1]           *
+ * f(x,y,z) = min(f1,f2), fi = (x-XCi)^2 + (y-YCi)^2 + (z-ZCi)^2 - Ri^2       *
+ * INPUT PARAMETERS:                                                          *
+ * (XCi,YCi,ZCi) center of bubble i; Ri: its radius                           *
+ * -------------------------------------------------------------------------- */
+
+real impl_func(void *userdata,creal xy[])
+{
+  double x,y,z,f1,f2;
+
+  x = xy[0];
+  y = xy[1];
+  z = xy[2];
+
+  f1 = (x - XC1)*(x - XC1) + (y - YC1)*(y - YC1) + (z - ZC1)*(z - ZC1) - R1*R1;
+  f2 = (x - XC2)*(x - XC2) + (y - YC2)*(y - YC2) + (z - ZC2)*(z - ZC2) - R2*R2;
+
+  return (f1 < f2) ? f1 : f2;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void check_volume(creal vol_n)
+{
+  double vol_a;
+
+  vol_a = 4.*MYPI*(R1*R1*R1 + R2*R2*R2)/3.;
+
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"---------------------- C: bubbles check with the front driver ----------------------\n");
+  fprintf (stdout," * two bubbles inside the cube [%.1f,%.1f]x[%.1f,%.1f]x[%.1f,%.1f] in a %dX%dX%d grid     *\n", X0, X0+H, Y0, Y0+H, Z0, Z0+H, NMX, NMY, NMZ);
+  fprintf (stdout," * f(x,y,z) = min(f1,f2), fi = (x-XCi)^2 + (y-YCi)^2 + (z-ZCi)^2 - Ri^2            *\n");
+  fprintf (stdout," * one seed point for each bubble                                                  *\n");
+  fprintf (stdout," * PARAMETERS:                                                                     *\n");
+  fprintf (stdout," * Ri: radius of bubble i; (XCi,YCi,ZCi) its center                                *\n");
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"r1:    %23.16e\n",R1);
+  fprintf (stdout,"xc1:   %23.16e\n",XC1);
+  fprintf (stdout,"yc1:   %23.16e\n",YC1);
+  fprintf (stdout,"zc1:   %23.16e\n",ZC1);
+  fprintf (stdout,"r2:    %23.16e\n",R2);
+  fprintf (stdout,"xc2:   %23.16e\n",XC2);
+  fprintf (stdout,"yc2:   %23.16e\n",YC2);
+  fprintf (stdout,"zc2:   %23.16e\n",ZC2);
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"analytical volume: %23.16e\n",vol_a);
+  fprintf (stdout,"numerical  volume: %23.16e\n\n",vol_n);
+  fprintf (stdout,"absolute error   : %23.16e\n",fabs(vol_a-vol_n));
+  fprintf (stdout,"relative error   : %23.16e\n",fabs(vol_a-vol_n)/vol_a); 
+  fprintf (stdout,"----------------- C: end bubbles check --------------------\n");
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"\n");
+
+  return;
+}
@@ -0,0 +1,42 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/* grid resolution */
+#define NMX   64
+#define NMY   64
+#define NMZ   64
+
+/* computational box */
+#define X0  0.0
+#define Y0  0.0
+#define Z0  0.0
+#define  H  1.0
+
+#define  MYPI   3.141592653589793238462643
+
+/* radius and center of the first bubble */
+#define  R1      0.12
+#define  XC1     0.31
+#define  YC1     0.34
+#define  ZC1     0.37
+
+/* radius and center of the second bubble */
+#define  R2      0.08
+#define  XC2     0.68
+#define  YC2     0.63
+#define  ZC2     0.59
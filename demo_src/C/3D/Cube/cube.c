@@ -0,0 +1,132 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "cube.h"
+
+typedef const double creal;
+typedef const int cint;
+typedef double real;
+
+static double rot[3][3];
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * rotation matrix R = Rz(ALPHA) Ry(BETA) Rx(GAMMA) of the box                *
+ * -------------------------------------------------------------------------- */
+
+void init()
+{
+  double rz[3][3],ry[3][3],rx[3][3],rt[3][3];
+  int i,j,k;
+
+  for (i=0;i<3;i++)
+    for (j=0;j<3;j++)
+      rz[i][j] = ry[i][j] = rx[i][j] = (i == j) ? 1. : 0.;
+  rz[0][0] = rz[1][1] = cos(ALPHA);
+  rz[1][0] = sin(ALPHA);
+  rz[0][1] = -rz[1][0];
+  ry[0][0] = ry[2][2] = cos(BETA);
+  ry[0][2] = sin(BETA);
+  ry[2][0] = -ry[0][2];
+  rx[1][1] = rx[2][2] = cos(GAMMA);
+  rx[2][1] = sin(GAMMA);
+  rx[1][2] = -rx[2][1];
+
+  for (i=0;i<3;i++)
+    for (j=0;j<3;j++) {
+      rt[i][j] = 0.;
+      for (k=0;k<3;k++)
+	rt[i][j] += rz[i][k]*ry[k][j];
+    }
+  for (i=0;i<3;i++)
+    for (j=0;j<3;j++) {
+      rot[i][j] = 0.;
+      for (k=0;k<3;k++)
+	rot[i][j] += rt[i][k]*rx[k][j];
+    }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION (reference phase where f(x,y,z) < 0):                          *
+ * rotated rectangular box inside the cube [0,1]x[0,1]x[0,1]                  *
+ * f(x) = max_i (|r_i.(x-xc)| - s_i), r_i: i-th row of R, s = (A1,B1,C1)      *
+ * INPUT PARAMETERS:                                                          *
+ * (XC,YC,ZC) center of the box; A1,B1,C1: its half sides;                    *
+ * ALPHA,BETA,GAMMA: rotation angles                                          *
+ * -------------------------------------------------------------------------- */
+
+real impl_func(void *userdata,creal xy[])
+{
+  double xc[3],s[3],d,f;
+  int i;
+
+  xc[0] = xy[0] - XC;
+  xc[1] = xy[1] - YC;
+  xc[2] = xy[2] - ZC;
+  s[0] = A1;
+  s[1] = B1;
+  s[2] = C1;
+
+  f = -1.e30;
+  for (i=0;i<3;i++) {
+    d = fabs(rot[i][0]*xc[0] + rot[i][1]*xc[1] + rot[i][2]*xc[2]) - s[i];
+    f = (d > f) ? d : f;
+  }
+
+  return f;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void check_volume(creal vol_n,creal dcc,const long int nfunc[])
+{
+  double vol_a;
+
+  vol_a = 8.*A1*B1*C1;
+
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"-------------------- C: box check with the planar interfaces -----------------------\n");
+  fprintf (stdout," * rotated box inside the cube [%.1f,%.1f]x[%.1f,%.1f]x[%.1f,%.1f] in a %dX%dX%d grid      *\n", X0, X0+H, Y0, Y0+H, Z0, Z0+H, NMX, NMY, NMZ);
+  fprintf (stdout," * f(x) = max_i (|r_i.(x-xc)| - s_i), r_i: i-th row of R, s = (A1,B1,C1)             *\n");
+  fprintf (stdout," * PARAMETERS:                                                                     *\n");
+  fprintf (stdout," * A1,B1,C1: half sides; (XC,YC,ZC) center; R = Rz(ALPHA) Ry(BETA) Rx(GAMMA)       *\n");
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"a1:    %23.16e\n",A1);
+  fprintf (stdout,"b1:    %23.16e\n",B1);
+  fprintf (stdout,"c1:    %23.16e\n",C1);
+  fprintf (stdout,"xc:    %23.16e\n",XC);
+  fprintf (stdout,"yc:    %23.16e\n",YC);
+  fprintf (stdout,"zc:    %23.16e\n",ZC);
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"analytical volume: %23.16e\n",vol_a);
+  fprintf (stdout,"numerical  volume: %23.16e\n\n",vol_n);
+  fprintf (stdout,"absolute error   : %23.16e\n",fabs(vol_a-vol_n));
+  fprintf (stdout,"relative error   : %23.16e\n",fabs(vol_a-vol_n)/vol_a); 
+  fprintf (stdout,"max cell difference with the numerical integration: %23.16e\n",dcc);
+  fprintf (stdout,"function evaluations, with/without the planar test: %ld %ld\n",nfunc[1],nfunc[0]);
+  fprintf (stdout,"------------------- C: end box check ----------------------\n");
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"\n");
+
+  return;
+}
@@ -0,0 +1,100 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "cube.h"
+
+#define NDIM  3
+#define N3D   3
+#define TOLC  1.0e-12
+
+extern void init();
+extern void check_volume(vofi_creal,vofi_creal,const long int []);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE TEST OF A LINEAR FUNCTION: THE VOLUME FRACTION OF A   *
+ * ROTATED BOX IS COMPUTED WITH THE ANALYTIC RELATIONS OF A PLANE IN THE      *
+ * CELLS CUT BY A SINGLE FACE, AND COMPARED CELL BY CELL WITH THE NUMERICAL   *
+ * INTEGRATION; THE CELLS CUT BY AN EDGE OR A VERTEX MUST BE REJECTED BY THE  *
+ * TEST                                                                       *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,i;
+  vofi_real *ccp,*ccn,x0[NDIM];
+  vofi_grid grid;
+  vofi_opts opts = {0};
+  vofi_stats st[2];
+  long int nfunc[2];
+  double h0,fh,vol_p,dcc;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with and without the planar test     * 
+ * -------------------------------------------------------------------------- */
+   
+  init();
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  ccp = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  ccn = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.opts = &opts;
+
+  /* numerical integration in all cut cells */
+  for (i=0;i<2;i++)
+    st[i].nfunc = st[i].nsave = 0;
+  opts.stats = &st[0];
+  vofi_Get_cc_grid(impl_func,NULL,&grid,fh,ccn);
+
+  /* analytic relations in the cells cut by a plane */
+  opts.stats = &st[1];
+  opts.plane = PLANE;
+  vol_p = vofi_Get_cc_grid(impl_func,NULL,&grid,fh,ccp);
+
+  dcc = 0.;
+  for (i=0;i<NMX*NMY*NMZ;i++)
+    dcc = (fabs(ccp[i]-ccn[i]) > dcc) ? fabs(ccp[i]-ccn[i]) : dcc;
+  nfunc[0] = st[0].nfunc;
+  nfunc[1] = st[1].nfunc;
+
+  check_volume(vol_p,dcc,nfunc);
+
+  free(ccp);
+  free(ccn);
+
+  return (dcc < TOLC && nfunc[1] < nfunc[0]) ? 0 : 1;
+}
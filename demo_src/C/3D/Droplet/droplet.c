@@ -0,0 +1,79 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "droplet.h"
+
+typedef const double creal;
+typedef const int cint;
+typedef double real;
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION (reference phase where f(x,y,z) < 0):                          *
+ * small spherical droplet inside the cube [0,1]x[0,1]x[0,1]                  *
+ * f(x,y,z) = (x-XC)^2 + (y-YC)^2 + (z-ZC)^2 - R0^2                           *
+ * INPUT PARAMETERS:                                                          *
+ * (XC,YC,ZC) center of the droplet; R0: its radius                           *
+ * -------------------------------------------------------------------------- */
+
+real impl_func(void *userdata,creal xy[])
+{
+  double x,y,z,f0;
+
+  x = xy[0];
+  y = xy[1];
+  z = xy[2];
+
+  f0 = (x - XC)*(x - XC) + (y - YC)*(y - YC) + (z - ZC)*(z - ZC) - R0*R0;
+
+  return f0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void check_volume(creal vol_n)
+{
+  double vol_a;
+
+  vol_a = 4.*MYPI*R0*R0*R0/3.;
+
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"--------------------- C: droplet check with the whole-grid driver ------------------\n");
+  fprintf (stdout," * droplet inside the cube [%.1f,%.1f]x[%.1f,%.1f]x[%.1f,%.1f] in a %dX%dX%d grid         *\n", X0, X0+H, Y0, Y0+H, Z0, Z0+H, NMX, NMY, NMZ);
+  fprintf (stdout," * f(x,y,z) = (x-XC)^2 + (y-YC)^2 + (z-ZC)^2 - R0^2                                *\n");
+  fprintf (stdout," * blocks of %dX%dX%d cells for the hierarchical classification                       *\n", NBX, NBX, NBX);
+  fprintf (stdout," * PARAMETERS:                                                                     *\n");
+  fprintf (stdout," * R0: radius of the droplet; (XC,YC,ZC) its center                                *\n");
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"r0:    %23.16e\n",R0);
+  fprintf (stdout,"xc:    %23.16e\n",XC);
+  fprintf (stdout,"yc:    %23.16e\n",YC);
+  fprintf (stdout,"zc:    %23.16e\n",ZC);
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"analytical volume: %23.16e\n",vol_a);
+  fprintf (stdout,"numerical  volume: %23.16e\n\n",vol_n);
+  fprintf (stdout,"absolute error   : %23.16e\n",fabs(vol_a-vol_n));
+  fprintf (stdout,"relative error   : %23.16e\n",fabs(vol_a-vol_n)/vol_a); 
+  fprintf (stdout,"----------------- C: end droplet check --------------------\n");
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"\n");
+
+  return;
+}
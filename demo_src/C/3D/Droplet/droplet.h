@@ -0,0 +1,41 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/* grid resolution */
+#define NMX   64
+#define NMY   64
+#define NMZ   64
+
+/* size of the blocks of cells of the hierarchical classification */
+#define NBX   8
+
+/* computational box */
+#define X0  0.0
+#define Y0  0.0
+#define Z0  0.0
+#define  H  1.0
+
+#define  MYPI   3.141592653589793238462643
+
+/* radius of the droplet */
+#define  R0      0.1
+
+/* its center */
+#define  XC      0.43
+#define  YC      0.51
+#define  ZC      0.47
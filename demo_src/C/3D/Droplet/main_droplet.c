@@ -0,0 +1,75 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO INITIALIZE THE COLOR FUNCTION SCALAR FIELD WITH THE WHOLE-GRID  *
+ * DRIVER                                                                     *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue;
+  vofi_real *cc,x0[NDIM];
+  vofi_grid grid;
+  double h0,fh,vol_n;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with local Gauss integration          * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  cc = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nblk = NBX;
+
+  /* volume fraction in all cells, cc[i + NMX*(j + NMY*k)] */
+  vol_n = vofi_Get_cc_grid(impl_func,NULL,&grid,fh,cc);
+
+  check_volume(vol_n);
+
+  free(cc);
+
+  return 0;
+}
@@ -0,0 +1,135 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define TOLA  1.0e-10
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE APERTURES OF THE FACES AND THE WETTED FRACTIONS OF    *
+ * THE EDGES: IN EACH GRID PLANE x = const THE TOTAL WETTED AREA OF THE FACES *
+ * MUST BE THE AREA OF THE DISK PI*(R0^2 - (x-XC)^2), ON EACH GRID LINE ALONG *
+ * z THE TOTAL WETTED LENGTH OF THE EDGES MUST BE THE CHORD OF THE DROPLET,   *
+ * THE SUMS OVER ALL PLANES AND LINES ARE COMPARED WITH THE EXACT ONES        *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,i,j,k,nerr;
+  long int nf,ne;
+  vofi_real *cc,*af[NDIM],*ae[NDIM],x0[NDIM];
+  vofi_grid grid;
+  double h0,fh,vol_n,dx,dy,r2,area_n,area_a,len_n,len_a;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function and of the apertures                 * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  nf = (long int) (NMX+1)*(NMY+1)*(NMZ+1);
+  cc = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  for (i=0;i<NDIM;i++) {
+    af[i] = (vofi_real *) malloc(sizeof(vofi_real)*nf);
+    ae[i] = (vofi_real *) malloc(sizeof(vofi_real)*nf);
+  }
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nblk = NBX;
+
+  /* faces normal to x: af[0][i + (NMX+1)*(j + NMY*k)], 
+     edges along z: ae[2][i + (NMX+1)*(j + (NMY+1)*k)] */
+  vol_n = vofi_Get_apertures(impl_func,NULL,&grid,fh,cc,af,ae);
+
+  /* the apertures must be in [0,1] */
+  nerr = 0;
+  for (nf=0;nf<(long int) (NMX+1)*NMY*NMZ;nf++)
+    if (af[0][nf] < 0. || af[0][nf] > 1.)
+      nerr++;
+
+  /* wetted area of the faces of the planes x = const */
+  area_n = area_a = 0.;
+  for (i=0;i<=NMX;i++) {
+    dx = X0 + i*h0 - XC;
+    if (R0*R0 > dx*dx)
+      area_a += MYPI*(R0*R0 - dx*dx);
+    for (k=0;k<NMZ;k++)
+      for (j=0;j<NMY;j++) {
+	nf = i + (NMX+1)*(j + (long int) NMY*k);
+	area_n += af[0][nf]*h0*h0;
+      }
+  }
+
+  /* wetted length of the edges of the lines along z */
+  len_n = len_a = 0.;
+  for (j=0;j<=NMY;j++)
+    for (i=0;i<=NMX;i++) {
+      dx = X0 + i*h0 - XC;
+      dy = Y0 + j*h0 - YC;
+      r2 = R0*R0 - dx*dx - dy*dy;
+      if (r2 > 0.)
+	len_a += 2.*sqrt(r2);
+      for (k=0;k<NMZ;k++) {
+	ne = i + (NMX+1)*(j + (NMY+1)*(long int) k);
+	len_n += ae[2][ne]*h0;
+      }
+    }
+
+  fprintf(stdout,"faces with an aperture outside [0,1]: %d\n",nerr);
+  fprintf(stdout,"analytical wetted area of the faces : %23.16e\n",area_a);
+  fprintf(stdout,"numerical  wetted area of the faces : %23.16e\n",area_n);
+  fprintf(stdout,"relative error                      : %23.16e\n",
+	  fabs(area_n - area_a)/area_a);
+  fprintf(stdout,"analytical wetted length of the edges: %23.16e\n",len_a);
+  fprintf(stdout,"numerical  wetted length of the edges: %23.16e\n",len_n);
+  fprintf(stdout,"relative error                       : %23.16e\n\n",
+	  fabs(len_n - len_a)/len_a);
+
+  check_volume(vol_n);
+
+  free(cc);
+  for (i=0;i<NDIM;i++) {
+    free(af[i]);
+    free(ae[i]);
+  }
+
+  return (nerr == 0 && fabs(area_n - area_a) < TOLA*area_a && 
+	  fabs(len_n - len_a) < TOLA*len_a) ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define ZINT  0.5
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function of the droplet that interrupts the process when it is    *
+ * evaluated above the plane z = ZINT + h0/4, as a crash during the run       *
+ * -------------------------------------------------------------------------- */
+
+vofi_real crash_func(void *cdata,vofi_creal xy[])
+{
+  if (xy[2] > ZINT + 0.25*H/NMZ)
+    _exit(2);
+  return impl_func(cdata,xy);
+}
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO INITIALIZE THE COLOR FUNCTION SCALAR FIELD IN A FILE, SLAB BY   *
+ * SLAB, WITHOUT KEEPING THE WHOLE FIELD IN MEMORY: A FIRST RUN IS            *
+ * INTERRUPTED HALFWAY, THE SECOND ONE RESTARTS FROM THE COMPLETED PLANES;    *
+ * THE FILE MUST BE EQUAL, BIT BY BIT, TO THE ARRAY OF THE WHOLE-GRID DRIVER  *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,kdone,status,nerr;
+  long int np;
+  vofi_real *cc,*ccf,x0[NDIM];
+  vofi_grid grid;
+  double h0,fh,vol_n,vol_g;
+  const char *fname = "droplet_cc.dat";
+  const char *rname = "droplet_cc.dat.rst";
+  FILE *fp;
+  pid_t pid;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with local Gauss integration          *
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  np = (long int) NMX*NMY*NMZ;
+  cc = (vofi_real *) malloc(sizeof(vofi_real)*np);
+  ccf = (vofi_real *) malloc(sizeof(vofi_real)*np);
+  if (cc == NULL || ccf == NULL) {
+    fprintf(stderr,"Out of memory\n");
+    return 1;
+  }
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nblk = NBX;
+  nerr = 0;
+
+  /* first run in a child process, interrupted above the plane z = ZINT */
+  remove(rname);
+  fflush(stdout);
+  pid = fork();
+  if (pid == 0) {
+    vofi_Get_cc_file(crash_func,NULL,&grid,fh,fname,0);
+    _exit(0);
+  }
+  if (pid < 0 || waitpid(pid,&status,0) != pid || !WIFEXITED(status) || 
+      WEXITSTATUS(status) != 2) {
+    fprintf(stderr,"The first run has not been interrupted\n");
+    nerr++;
+  }
+
+  /* the completed planes of the interrupted run */
+  kdone = 0;
+  fp = fopen(rname,"r");
+  if (fp == NULL || fscanf(fp,"%d",&kdone) != 1 || kdone <= 0 || kdone >= NMZ)
+    nerr++;
+  if (fp != NULL)
+    fclose(fp);
+  fprintf(stdout,"planes completed before the interruption: %d\n",kdone);
+
+  /* volume fraction in all cells written to the file, slabs of NBX planes,
+     restart from the interrupted run */
+  vol_n = vofi_Get_cc_file(impl_func,NULL,&grid,fh,fname,itrue);
+  if (vol_n < 0.)
+    nerr++;
+
+  check_volume(vol_n);
+
+  /* the file must be equal to the array of the whole-grid driver */
+  vol_g = vofi_Get_cc_grid(impl_func,NULL,&grid,fh,cc);
+  fp = fopen(fname,"rb");
+  if (fp == NULL || fread(ccf,sizeof(vofi_real),np,fp) != (size_t) np ||
+      memcmp(ccf,cc,np*sizeof(vofi_real)) != 0)
+    nerr++;
+  if (fp != NULL)
+    fclose(fp);
+  fp = fopen(rname,"r");                 /* removed at the end of the run */
+  if (fp != NULL) {
+    fclose(fp);
+    nerr++;
+  }
+  fprintf(stdout,"volume with the whole-grid driver: %23.16e\n",vol_g);
+  fprintf(stdout,"errors after the restart: %d\n",nerr);
+
+  remove(fname);
+  free(cc);
+  free(ccf);
+
+  return (nerr == 0) ? 0 : 1;
+}
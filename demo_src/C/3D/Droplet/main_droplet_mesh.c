@@ -0,0 +1,175 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NE    32
+#define AMP   0.3
+#define TOLM  1.0e-12
+#define TOLT  1.0e-10
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function of the droplet with a counter of the evaluations         *
+ * -------------------------------------------------------------------------- */
+
+vofi_real count_func(void *cdata,vofi_creal xy[])
+{
+  (*((long int *) cdata))++;
+  return impl_func(NULL,xy);
+}
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE VOLUME FRACTION OF THE ELEMENTS OF AN UNSTRUCTURED    *
+ * MESH OF THE UNIT CUBE WITH WARPED INTERNAL NODES: A MESH OF HEXAHEDRA AND  *
+ * A MESH OF TETRAHEDRA, SIX IN EACH HEXAHEDRON; THE ELEMENTS MUST FILL THE   *
+ * CUBE AND THE VOLUME OF THE REFERENCE PHASE MUST BE THAT OF THE DROPLET     *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  /* corners of the six tetrahedra of a hexahedron, (i,j,k) -> i + 2*j + 4*k */
+  const int ktet[6][4] = {{0,1,3,7},{0,1,5,7},{0,2,3,7},{0,2,6,7},{0,4,5,7},{0,4,6,7}};
+  vofi_cint ndim0=N3D;
+  vofi_mesh mesh;
+  int i,j,k,c,n,p,t,m,nv,itype,nerr,ncut;
+  long int e,nf,nod[8],*ielm,*ivrt;
+  vofi_real *xnod,*cc,*ve,xs[NDIM],xv[8*NDIM];
+  double h0,fh,sn,vol_n,vol_e,vc,tol;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the nodes and of the connectivity of the two meshes      * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/NE;
+  xnod = (vofi_real *) malloc(NDIM*(NE+1)*(NE+1)*(NE+1)*sizeof(vofi_real));
+  ielm = (long int *) malloc((6*NE*NE*NE+1)*sizeof(long int));
+  ivrt = (long int *) malloc(24*NE*NE*NE*sizeof(long int));
+  cc = (vofi_real *) malloc(6*NE*NE*NE*sizeof(vofi_real));
+  ve = (vofi_real *) malloc(6*NE*NE*NE*sizeof(vofi_real));
+  if (xnod == NULL || ielm == NULL || ivrt == NULL || cc == NULL || ve == NULL) {
+    fprintf(stderr,"Out of memory\n");
+    return 1;
+  }
+
+  /* the internal nodes are moved, the boundary of the cube is kept */
+  for (k=0;k<=NE;k++)
+    for (j=0;j<=NE;j++)
+      for (i=0;i<=NE;i++) {
+	m = i + (NE+1)*(j + (NE+1)*k);
+	xs[0] = X0 + i*h0;
+	xs[1] = Y0 + j*h0;
+	xs[2] = Z0 + k*h0;
+	sn = AMP*h0*sin(2.*MYPI*xs[0])*sin(2.*MYPI*xs[1])*sin(2.*MYPI*xs[2]);
+	xnod[NDIM*m] = xs[0] + sn;
+	xnod[NDIM*m+1] = xs[1] - 0.7*sn;
+	xnod[NDIM*m+2] = xs[2] + 0.5*sn;
+      }
+
+  /* get the characteristic value fh of the implicit function */
+  xs[0] = 0.5;
+  xs[1] = 0.5; 
+  xs[2] = 0.5; 
+  fh = vofi_Get_fh(impl_func,NULL,xs,(1. + AMP)*h0,ndim0,1);
+
+  nerr = 0;
+  for (itype=0;itype<2;itype++) {            /* hexahedra, then tetrahedra */
+    mesh.ndim = ndim0;
+    mesh.nnod = (NE+1)*(NE+1)*(NE+1);
+    mesh.xnod = xnod;
+    mesh.nthr = 1;
+    mesh.ielm = ielm;
+    mesh.ivrt = ivrt;
+    e = 0;
+    ielm[0] = 0;
+    for (k=0;k<NE;k++)
+      for (j=0;j<NE;j++)
+	for (i=0;i<NE;i++) {
+	  for (c=0;c<8;c++)
+	    nod[c] = (i + (c & 1)) + (NE+1)*((j + ((c >> 1) & 1)) + (NE+1)*(k + (c >> 2)));
+	  if (itype == 0) {               /* hexahedron in the order of VTK */
+	    ivrt[ielm[e]] = nod[0];
+	    ivrt[ielm[e]+1] = nod[1];
+	    ivrt[ielm[e]+2] = nod[3];
+	    ivrt[ielm[e]+3] = nod[2];
+	    ivrt[ielm[e]+4] = nod[4];
+	    ivrt[ielm[e]+5] = nod[5];
+	    ivrt[ielm[e]+6] = nod[7];
+	    ivrt[ielm[e]+7] = nod[6];
+	    ielm[e+1] = ielm[e] + 8;
+	    e++;
+	  }
+	  else
+	    for (t=0;t<6;t++) {
+	      for (c=0;c<4;c++)
+		ivrt[ielm[e]+c] = nod[ktet[t][c]];
+	      ielm[e+1] = ielm[e] + 4;
+	      e++;
+	    }
+	}
+    mesh.nelm = e;
+
+    vol_n = vofi_Get_cc_mesh(impl_func,NULL,&mesh,fh,cc,ve);
+    vol_e = 0.;
+    ncut = 0;
+    nf = 0;
+    for (e=0;e<mesh.nelm;e++) {
+      vol_e += ve[e];
+      if (cc[e] < 0. || cc[e] > 1.)
+	nerr++;
+      else if (cc[e] > 0. && cc[e] < 1.) {  /* evaluations of a cut element */
+	ncut++;
+	nv = (int) (ielm[e+1] - ielm[e]);
+	for (p=0;p<nv;p++)
+	  for (n=0;n<NDIM;n++)
+	    xv[NDIM*p+n] = xnod[NDIM*ivrt[ielm[e]+p]+n];
+	if (vofi_Get_cc_elem(count_func,&nf,xv,nv,fh,ndim0,&vc) != cc[e])
+	  nerr++;
+      }
+    }
+    /* oblique faces of the tetrahedra: more tangency limits in the rules */
+    tol = (itype == 0) ? TOLM : TOLT;
+    if (fabs(vol_e - H*H*H) > TOLM || 
+	fabs(vol_n - 4.*MYPI*R0*R0*R0/3.) > tol*vol_n)
+      nerr++;
+
+    fprintf(stdout,"%s: %ld elements, %d cut elements\n",
+	    (itype == 0) ? "hexahedra" : "tetrahedra",mesh.nelm,ncut);
+    fprintf(stdout,"total volume of the elements: %23.16e\n",vol_e);
+    fprintf(stdout,"evaluations per cut element : %.1f\n\n",(double) nf/(ncut > 0 ? ncut : 1));
+
+    check_volume(vol_n);
+  }
+
+  free(xnod);
+  free(ielm);
+  free(ivrt);
+  free(cc);
+  free(ve);
+
+  return (nerr == 0) ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi_mpi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO INITIALIZE THE COLOR FUNCTION SCALAR FIELD WITH THE MPI DRIVER, *
+ * THE GRID IS SPLIT INTO SLABS ALONG Z, ONE FOR EACH RANK                    *
+ * -------------------------------------------------------------------------- */
+
+int main(int argc,char *argv[])
+{
+  vofi_cint ndim0=N3D,ng[NDIM]={1,1,1};
+  int itrue,rank,nproc,k0,nc[NDIM];
+  vofi_real *cc,x0[NDIM];
+  vofi_grid grid;
+  double h0,fh,vol_n;
+
+  MPI_Init(&argc,&argv);
+  MPI_Comm_rank(MPI_COMM_WORLD,&rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&nproc);
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with local Gauss integration          * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/NMX;                                                 /* grid spacing */
+  itrue = 1;
+
+  /* slab of this rank: cells k0 <= k < k0+nc[2] */
+  nc[0] = NMX;
+  nc[1] = NMY;
+  nc[2] = NMZ/nproc + (rank < NMZ%nproc ? 1 : 0);
+  k0 = rank*(NMZ/nproc) + (rank < NMZ%nproc ? rank : NMZ%nproc);
+  cc = (vofi_real *) malloc(sizeof(vofi_real)*(nc[0]+2*ng[0])*(nc[1]+2*ng[1])*(nc[2]+2*ng[2]));
+
+  /* starting point to get fh (only that of rank 0 is used) */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = Z0 + (k0 + 0.5*nc[2])*h0; 
+
+  /* get the characteristic value fh of the implicit function on rank 0 */
+  fh = vofi_Get_fh_mpi(impl_func,NULL,x0,h0,ndim0,itrue,MPI_COMM_WORLD);
+ 
+  /* put now starting point in the minor vertex of the slab */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0 + k0*h0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nblk = NBX;
+
+  /* volume fraction in the slab and in its ghost cells, total volume */
+  vol_n = vofi_Get_cc_mpi(impl_func,NULL,&grid,ng,fh,MPI_COMM_WORLD,cc);
+
+  if (rank == 0)
+    check_volume(vol_n);
+
+  free(cc);
+  MPI_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define TOLP  1.0e-12
+#define TOLN  0.95
+#define TOLA  1.0e-2
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE INTERFACE OF THE CUT CELLS: ALL THE INTERSECTIONS     *
+ * MUST BE ON THE SPHERE, THE NORMAL OF THE PLANE OF EACH CELL CLOSE TO THE   *
+ * RADIAL DIRECTION AND THE TOTAL AREA OF THE POLYGONS OF THE INTERSECTIONS   *
+ * CLOSE TO THE AREA OF THE SPHERE, 4*PI*R0^2                                 *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,n,nerr;
+  long int c,m,p,q,ncut;
+  vofi_real *cc,x0[NDIM],xs[NDIM],xr[NDIM],a[NDIM],b[NDIM],s[NDIM];
+  vofi_grid grid;
+  vofi_plic pl;
+  double h0,fh,vol_n,dr,dmax,cmin,cn,area_n,area_a;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function and of the interface of the cut cells *
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  cc = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nblk = NBX;
+
+  vol_n = vofi_Get_plic(impl_func,NULL,&grid,fh,cc,&pl);
+
+  /* the cut cells must be those with 0 < cc < 1 */
+  ncut = 0;
+  for (m=0;m<(long int) NMX*NMY*NMZ;m++)
+    if (cc[m] > 0. && cc[m] < 1.)
+      ncut++;
+  nerr = (ncut == pl.ncut) ? 0 : 1;
+
+  dmax = area_n = 0.;
+  cmin = 1.;
+  for (c=0;c<pl.ncut;c++) {
+    m = pl.icut[c];                    /* radial direction in the cell center */
+    xr[0] = X0 + (m % NMX + 0.5)*h0 - XC;
+    xr[1] = Y0 + ((m / NMX) % NMY + 0.5)*h0 - YC;
+    xr[2] = Z0 + (m / ((long int) NMX*NMY) + 0.5)*h0 - ZC;
+    dr = sqrt(xr[0]*xr[0] + xr[1]*xr[1] + xr[2]*xr[2]);
+    cn = 0.;
+    for (n=0;n<NDIM;n++)
+      cn += pl.pln[4*c+n]*xr[n]/dr;
+    cmin = (cn < cmin) ? cn : cmin;
+
+    s[0] = s[1] = s[2] = 0.;             /* vector area of the polygon */
+    for (p=pl.ipt[c];p<pl.ipt[c+1];p++) {
+      q = (p+1 < pl.ipt[c+1]) ? p+1 : pl.ipt[c];
+      for (n=0;n<NDIM;n++) {
+	a[n] = pl.xpt[3*p+n];
+	b[n] = pl.xpt[3*q+n];
+	xs[n] = a[n];
+      }
+      s[0] += 0.5*(a[1]*b[2] - a[2]*b[1]);
+      s[1] += 0.5*(a[2]*b[0] - a[0]*b[2]);
+      s[2] += 0.5*(a[0]*b[1] - a[1]*b[0]);
+      dr = sqrt((xs[0]-XC)*(xs[0]-XC) + (xs[1]-YC)*(xs[1]-YC) + (xs[2]-ZC)*(xs[2]-ZC));
+      dmax = (fabs(dr - R0) > dmax) ? fabs(dr - R0) : dmax;
+    }
+    area_n += sqrt(s[0]*s[0] + s[1]*s[1] + s[2]*s[2]);
+  }
+  area_a = 4.*MYPI*R0*R0;
+
+  fprintf(stdout,"cut cells: %ld, points: %ld\n",pl.ncut,pl.npt);
+  fprintf(stdout,"maximum distance of the points from the sphere: %23.16e\n",dmax);
+  fprintf(stdout,"minimum cosine of the normal with the radius  : %23.16e\n",cmin);
+  fprintf(stdout,"analytical area of the sphere  : %23.16e\n",area_a);
+  fprintf(stdout,"numerical  area of the polygons: %23.16e\n",area_n);
+  fprintf(stdout,"relative error                 : %23.16e\n\n",
+	  fabs(area_n - area_a)/area_a);
+
+  check_volume(vol_n);
+
+  free(cc);
+  vofi_Free_plic(&pl);
+
+  return (nerr == 0 && dmax < TOLP*R0 && cmin > TOLN && 
+	  fabs(area_n - area_a) < TOLA*area_a) ? 0 : 1;
+}
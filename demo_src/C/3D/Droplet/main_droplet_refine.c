@@ -0,0 +1,110 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NREF  4
+#define TOLR  1.0e-14
+#define TOLS  1.0e-12
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE VOLUME FRACTION OF THE SUB-CELLS OF THE CUT CELLS:    *
+ * THE SUB-CELLS MUST SUM TO THE VOLUME FRACTION OF vofi_Get_cc OF THE CELL,  *
+ * EACH SUB-CELL MUST BE CLOSE TO vofi_Get_cc OF THE SUB-CELL ITSELF          *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,i,j,k,m,ns,ncut,nerr;
+  vofi_real x0[NDIM],xloc[NDIM],xsub[NDIM],ccs[NREF*NREF*NREF];
+  double h0,hs,fh,cc,cr,sum,dmax,vol_n;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with the sub-cells of the cut cells  * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  hs = h0/NREF;
+  ns = NREF*NREF*NREF;
+  itrue = 1;
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+
+  ncut = nerr = 0;
+  dmax = vol_n = 0.;
+  for (k=0;k<NMZ;k++)
+    for (j=0;j<NMY;j++) 
+      for (i=0;i<NMX;i++) {
+	xloc[0] = x0[0] + i*h0;
+	xloc[1] = x0[1] + j*h0;
+	xloc[2] = x0[2] + k*h0;
+	cc = vofi_Get_cc(impl_func,NULL,xloc,h0,fh,ndim0);
+	if (cc > 0. && cc < 1.) {
+	  ncut++;
+	  cr = vofi_Get_cc_refine(impl_func,NULL,xloc,h0,fh,ndim0,NREF,ccs);
+	  if (fabs(cr - cc) > TOLR)
+	    nerr++;
+	  sum = 0.;
+	  for (m=0;m<ns;m++) {
+	    sum += ccs[m];
+	    if (ccs[m] < 0. || ccs[m] > 1.)
+	      nerr++;
+	    xsub[0] = xloc[0] + (m%NREF)*hs;
+	    xsub[1] = xloc[1] + ((m/NREF)%NREF)*hs;
+	    xsub[2] = xloc[2] + (m/(NREF*NREF))*hs;
+	    cr = fabs(ccs[m] - vofi_Get_cc(impl_func,NULL,xsub,hs,fh/NREF,ndim0));
+	    if (cr > dmax)
+	      dmax = cr;
+	  }
+	  if (fabs(sum - ns*cc) > ns*TOLR)
+	    nerr++;
+	  cc = sum/ns;
+	}
+	vol_n += cc;
+      }
+  vol_n = vol_n*h0*h0*h0;
+
+  fprintf(stdout,"cut cells refined with %d^3 sub-cells: %d\n",NREF,ncut);
+  fprintf(stdout,"cells whose sub-cells do not sum to vofi_Get_cc: %d\n",nerr);
+  fprintf(stdout,"max difference from vofi_Get_cc of the sub-cells: %23.16e\n\n",dmax);
+
+  check_volume(vol_n);
+
+  return (nerr == 0 && dmax < TOLS) ? 0 : 1;
+}
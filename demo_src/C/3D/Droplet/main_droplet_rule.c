@@ -0,0 +1,125 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NPR   4
+#define MNOD  20000
+#define TOLC  1.0e-12
+#define TOLS  1.0e-5
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE QUADRATURE RULES OF THE CELLS: THE SUM OF THE WEIGHTS *
+ * OF THE VOLUME RULE MUST BE THE VOLUME FRACTION OF EACH CELL, THE VOLUME    *
+ * RULE GIVES THE CENTROID OF THE DROPLET AND THE INTERFACE RULE ITS AREA AND *
+ * THE FLUX OF x-xc THROUGH THE INTERFACE, THAT IS 3 TIMES THE VOLUME         *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,i,j,k,n,nerr;
+  vofi_real x0[NDIM],xloc[NDIM];
+  vofi_rule rule;
+  double h0,fh,cc,sw,vol_n,xm_n,area_n,flux_n,area_a,dcc;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function and of the quadrature rules           * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  rule.npr = NPR;
+  rule.mvol = rule.msrf = MNOD;
+  rule.xvol = (vofi_real *) malloc(sizeof(vofi_real)*NDIM*MNOD);
+  rule.wvol = (vofi_real *) malloc(sizeof(vofi_real)*MNOD);
+  rule.xsrf = (vofi_real *) malloc(sizeof(vofi_real)*NDIM*MNOD);
+  rule.wsrf = (vofi_real *) malloc(sizeof(vofi_real)*MNOD);
+  rule.vsrf = (vofi_real *) malloc(sizeof(vofi_real)*NDIM*MNOD);
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+
+  nerr = 0;
+  dcc = vol_n = xm_n = area_n = flux_n = 0.;
+  for (k=0;k<NMZ;k++)
+    for (j=0;j<NMY;j++) 
+      for (i=0;i<NMX;i++) {
+	xloc[0] = x0[0] + i*h0;
+	xloc[1] = x0[1] + j*h0;
+	xloc[2] = x0[2] + k*h0;
+	cc = vofi_Get_cc_rule(impl_func,NULL,xloc,h0,fh,ndim0,&rule);
+	if (rule.nvol > rule.mvol || rule.nsrf > rule.msrf)
+	  nerr++;
+	sw = 0.;
+	for (n=0;n<rule.nvol && n<rule.mvol;n++) {
+	  sw += rule.wvol[n];
+	  xm_n += rule.wvol[n]*rule.xvol[NDIM*n];
+	}
+	vol_n += sw;
+	dcc = (fabs(sw/(h0*h0*h0) - cc) > dcc) ? fabs(sw/(h0*h0*h0) - cc) : dcc;
+	for (n=0;n<rule.nsrf && n<rule.msrf;n++) {
+	  area_n += rule.wsrf[n];
+	  flux_n += rule.wsrf[n]*(rule.vsrf[NDIM*n]*(rule.xsrf[NDIM*n] - XC) + 
+				  rule.vsrf[NDIM*n+1]*(rule.xsrf[NDIM*n+1] - YC) + 
+				  rule.vsrf[NDIM*n+2]*(rule.xsrf[NDIM*n+2] - ZC));
+	}
+      }
+  xm_n /= vol_n;
+  area_a = 4.*MYPI*R0*R0;
+
+  fprintf(stdout,"max difference of the volume rule and the volume fraction: %23.16e\n",dcc);
+  fprintf(stdout,"centroid x: %23.16e, error: %23.16e\n",xm_n,fabs(xm_n - XC));
+  fprintf(stdout,"area:       %23.16e, relative error: %23.16e\n",area_n,
+	  fabs(area_n - area_a)/area_a);
+  fprintf(stdout,"flux/3:     %23.16e, relative error: %23.16e\n\n",flux_n/3.,
+	  fabs(flux_n - 3.*vol_n)/(3.*vol_n));
+
+  check_volume(vol_n);
+
+  free(rule.xvol);
+  free(rule.wvol);
+  free(rule.xsrf);
+  free(rule.wsrf);
+  free(rule.vsrf);
+
+  if (nerr > 0 || dcc > TOLC || fabs(xm_n - XC) > TOLC || fabs(area_n - area_a) > TOLS*area_a ||
+      fabs(flux_n - 3.*vol_n) > TOLS*3.*vol_n)
+    return 1;
+
+  return 0;
+}
@@ -0,0 +1,104 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NBAND 3
+#define TOLD  1.0e-12
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE SIGNED DISTANCE IN A NARROW BAND: IN THE CELLS OF THE *
+ * BAND IT MUST BE THE EXACT ONE, |x - xc| - R0, AND IN THE OTHER CELLS THE   *
+ * BOUND dmax WITH THE SIGN OF THE PHASE OF THE CELL                          *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,i,j,k,nerr;
+  long int m,nband;
+  vofi_real *cc,*sd,x0[NDIM];
+  vofi_grid grid;
+  double h0,fh,vol_n,dx,dy,dz,sd_a,dmax,err;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function and of the signed distance            *
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  cc = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  sd = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nblk = NBX;
+
+  vol_n = vofi_Get_cc_sdf(impl_func,NULL,&grid,fh,NBAND,cc,sd);
+
+  dmax = (NBAND+1)*sqrt((double) N3D)*h0;
+  nerr = 0;
+  nband = 0;
+  err = 0.;
+  for (k=0;k<NMZ;k++)
+    for (j=0;j<NMY;j++)
+      for (i=0;i<NMX;i++) {
+	m = i + NMX*(j + (long int) NMY*k);
+	dx = X0 + (i+0.5)*h0 - XC;
+	dy = Y0 + (j+0.5)*h0 - YC;
+	dz = Z0 + (k+0.5)*h0 - ZC;
+	sd_a = sqrt(dx*dx + dy*dy + dz*dz) - R0;
+	if (fabs(sd[m]) < dmax) {                                   /* band */
+	  nband++;
+	  err = (fabs(sd[m] - sd_a) > err) ? fabs(sd[m] - sd_a) : err;
+	}
+	else if (sd[m]*sd_a <= 0. || fabs(sd_a) < (NBAND+0.5)*h0)
+	  nerr++;
+      }
+
+  fprintf(stdout,"cells in the band: %ld\n",nband);
+  fprintf(stdout,"cells outside the band with a wrong value: %d\n",nerr);
+  fprintf(stdout,"maximum error of the signed distance: %23.16e\n\n",err);
+
+  check_volume(vol_n);
+
+  free(cc);
+  free(sd);
+
+  return (nerr == 0 && err < TOLD*R0) ? 0 : 1;
+}
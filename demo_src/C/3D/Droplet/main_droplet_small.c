@@ -0,0 +1,170 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NS    16
+#define RS    1.5
+#define TOLS  1.0e-10
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function of a small droplet of radius RS*h0 centered in           *
+ * (2h0,2h0,2h0), h0 = H/NS, that spans a few cells of the first block, with  *
+ * a counter of the evaluations                                               *
+ * -------------------------------------------------------------------------- */
+
+vofi_real small_func(void *sdata,vofi_creal xy[])
+{
+  vofi_real h0,r0,xc,yc,zc;
+
+  (*(long int *) sdata)++;
+  h0 = H/NS;
+  r0 = RS*h0;
+  xc = X0 + 2.*h0;
+  yc = Y0 + 2.*h0;
+  zc = Z0 + 2.*h0;
+
+  return (xy[0]-xc)*(xy[0]-xc) + (xy[1]-yc)*(xy[1]-yc) + (xy[2]-zc)*(xy[2]-zc) - r0*r0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * exact interval extension of small_func in the box [xlo,xhi], with a        *
+ * counter of the evaluations                                                 *
+ * -------------------------------------------------------------------------- */
+
+void small_int(void *sdata,vofi_creal xlo[],vofi_creal xhi[],vofi_real fr[])
+{
+  int i;
+  vofi_real h0,r0,xc[NDIM],dl,dh;
+
+  (*(long int *) sdata)++;
+  h0 = H/NS;
+  r0 = RS*h0;
+  xc[0] = X0 + 2.*h0;
+  xc[1] = Y0 + 2.*h0;
+  xc[2] = Z0 + 2.*h0;
+
+  fr[0] = fr[1] = -r0*r0;
+  for (i=0;i<NDIM;i++) {
+    dl = (xlo[i]-xc[i])*(xlo[i]-xc[i]);
+    dh = (xhi[i]-xc[i])*(xhi[i]-xc[i]);
+    if (xlo[i] > xc[i] || xhi[i] < xc[i])
+      fr[0] += (dl < dh) ? dl : dh;
+    fr[1] += (dl > dh) ? dl : dh;
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE HIERARCHICAL CLASSIFICATION OF THE WHOLE-GRID DRIVER  *
+ * WITH A DROPLET SMALLER THAN A BLOCK: THE VALUES WITH THE DEFAULT BLOCKS    *
+ * MUST BE THOSE CELL BY CELL AND THE VOLUME THAT OF THE DROPLET, ALSO WITH   *
+ * THE INTERVAL EXTENSION, THAT MUST SAVE THE EVALUATIONS OF THE BLOCKS       *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NS,NS,NS},ndim0=N3D;
+  int itrue,nblk,ndif,nerr;
+  long int m,nf_n,nf_1,nf_c;
+  vofi_real *cc,*cc1,x0[NDIM];
+  vofi_grid grid;
+  vofi_opts opts = {0};
+  double h0,fh,vol_n,vol_1,vol_c,vol_a;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with the default blocks and cell by   *
+ * cell                                                                       *
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/NS;
+  itrue = 1;
+  cc = (vofi_real *) malloc(sizeof(vofi_real)*NS*NS*NS);
+  cc1 = (vofi_real *) malloc(sizeof(vofi_real)*NS*NS*NS);
+  if (cc == NULL || cc1 == NULL) {
+    fprintf(stderr,"Out of memory\n");
+    return 1;
+  }
+
+  /* get the characteristic value fh near the droplet */
+  x0[0] = X0 + 2.*h0;
+  x0[1] = Y0 + 2.*h0;
+  x0[2] = Z0 + 2.*h0;
+  nf_n = 0;
+  fh = vofi_Get_fh(small_func,&nf_n,x0,h0,ndim0,itrue);
+
+  x0[0] = X0;
+  x0[1] = Y0;
+  x0[2] = Z0;
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nthr = 1;
+  nblk = grid.nblk;
+  nf_n = 0;
+  vol_n = vofi_Get_cc_grid(small_func,&nf_n,&grid,fh,cc);
+  grid.nblk = 1;
+  nf_1 = 0;
+  vol_1 = vofi_Get_cc_grid(small_func,&nf_1,&grid,fh,cc1);
+
+  ndif = 0;
+  for (m=0;m<NS*NS*NS;m++)
+    if (cc[m] != cc1[m])
+      ndif++;
+  vol_a = 4.*MYPI*pow(RS*h0,3)/3.;
+  nerr = ndif;
+  if (fabs(vol_n - vol_a) > TOLS*vol_a)
+    nerr++;
+
+  /* with the certified test the blocks are not sampled: the values must be
+     those of the certified test cell by cell, with fewer evaluations */
+  opts.int_func = small_int;
+  grid.opts = &opts;
+  nf_c = 0;
+  vofi_Get_cc_grid(small_func,&nf_c,&grid,fh,cc1);
+  grid.nblk = nblk;
+  nf_c = 0;
+  vol_c = vofi_Get_cc_grid(small_func,&nf_c,&grid,fh,cc);
+  for (m=0;m<NS*NS*NS;m++)
+    if (cc[m] != cc1[m])
+      ndif++;
+  if (ndif > 0 || fabs(vol_c - vol_a) > TOLS*vol_a || nf_c >= nf_n)
+    nerr++;
+
+  fprintf(stdout,"droplet of radius %.1f h0 in a %dX%dX%d grid, blocks of %d cells\n",
+	  RS,NS,NS,NS,nblk);
+  fprintf(stdout,"analytical volume  : %23.16e\n",vol_a);
+  fprintf(stdout,"volume with blocks : %23.16e\n",vol_n);
+  fprintf(stdout,"volume cell by cell: %23.16e\n",vol_1);
+  fprintf(stdout,"volume int_func    : %23.16e\n",vol_c);
+  fprintf(stdout,"different cells    : %d\n",ndif);
+  fprintf(stdout,"f evaluations      : %ld with blocks, %ld cell by cell, %ld with int_func\n",
+	  nf_n,nf_1,nf_c);
+
+  free(cc);
+  free(cc1);
+
+  return (nerr == 0) ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NTHR  8
+#define NREP  4
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE WHOLE-GRID DRIVER WITH SEVERAL THREADS: THE CELLS ARE *
+ * PROCESSED ONE BY ONE BY NTHR THREADS, THAT SHARE THE INTERSECTIONS OF THE  *
+ * EDGES AND FACES, THE VALUES MUST BE THE SAME OF A SINGLE THREAD, WITH NO   *
+ * FEWER EVALUATIONS (AN EDGE ASKED BY TWO THREADS AT THE SAME TIME IS        *
+ * COMPUTED BY BOTH) (ALSO A STRESS TEST FOR THE THREAD SANITIZER, SEE THE    *
+ * OPTION --enable-tsan OF CONFIGURE)                                         *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,irep,nerr;
+  long int nfx;
+  vofi_real *cc1,*ccn,x0[NDIM];
+  vofi_grid grid;
+  vofi_opts opts = {0};
+  vofi_stats st1,stn;
+  double h0,fh,vol_1,vol_n;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with local Gauss integration          * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  cc1 = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  ccn = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid, cell by cell */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.nblk = 1;
+  grid.opts = &opts;
+
+  /* reference values with a single thread */
+  st1.nfunc = st1.nsave = 0;
+  opts.stats = &st1;
+  grid.nthr = 1;
+  vol_1 = vofi_Get_cc_grid(impl_func,NULL,&grid,fh,cc1);
+
+  /* same values with NTHR threads, the extra evaluations are edges computed
+     by two threads at the same time */
+  nerr = 0;
+  nfx = 0;
+  grid.nthr = NTHR;
+  for (irep=0;irep<NREP;irep++) {
+    stn.nfunc = stn.nsave = 0;
+    opts.stats = &stn;
+    vol_n = vofi_Get_cc_grid(impl_func,NULL,&grid,fh,ccn);
+    if (memcmp(cc1,ccn,sizeof(vofi_real)*NMX*NMY*NMZ) != 0 || vol_n != vol_1 ||
+	stn.nfunc < st1.nfunc)
+      nerr++;
+    if (stn.nfunc - st1.nfunc > nfx)
+      nfx = stn.nfunc - st1.nfunc;
+  }
+  fprintf(stdout,"%d threads, %d runs: %d with different values, %ld evaluations, "
+	  "at most %ld more with threads\n\n",NTHR,NREP,nerr,st1.nfunc,nfx);
+
+  check_volume(vol_n);
+
+  free(cc1);
+  free(ccn);
+
+  return (nerr == 0) ? 0 : 1;
+}
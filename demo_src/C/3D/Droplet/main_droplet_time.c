@@ -0,0 +1,150 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NPT   8
+#define UX    0.1
+#define TOLT  1.0e-14
+
+extern void check_volume(vofi_creal);
+
+/* nodes and weights of the Gauss-Legendre quadrature in [-1,1] with NPT nodes */
+static const double xgl[NPT] =
+{-0.96028985649753623168356090, -0.79666647741362673959155390,
+ -0.52553240991632898581773900, -0.18343464249564980493947610,
+  0.18343464249564980493947610,  0.52553240991632898581773900,
+  0.79666647741362673959155390,  0.96028985649753623168356090};
+
+static const double wgl[NPT] =
+{ 0.10122853629037625915253140,  0.22238103445337447054435600,
+  0.31370664587788728733796220,  0.36268378337836198296515040,
+  0.36268378337836198296515040,  0.31370664587788728733796220,
+  0.22238103445337447054435600,  0.10122853629037625915253140};
+
+/* counter of the function evaluations nf and time t of fixed_func */
+typedef struct {
+  long int nf;
+  double t;
+} cnt_data;
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * droplet moving along x with velocity UX, its center is (XC + UX*t,YC,ZC)   *
+ * -------------------------------------------------------------------------- */
+
+vofi_real time_func(void *tdata,vofi_creal xy[],vofi_creal t)
+{
+  cnt_data *pcn = (cnt_data *) tdata;
+  vofi_real dx = xy[0] - XC - UX*t;
+
+  pcn->nf++;
+  return dx*dx + (xy[1] - YC)*(xy[1] - YC) + (xy[2] - ZC)*(xy[2] - ZC) - R0*R0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * droplet at the time of the data, for vofi_Get_cc at the time nodes         *
+ * -------------------------------------------------------------------------- */
+
+vofi_real fixed_func(void *tdata,vofi_creal xy[])
+{
+  return time_func(tdata,xy,((cnt_data *) tdata)->t);
+}
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE VOLUME FRACTION AVERAGED OVER A TIME STEP OF A MOVING *
+ * DROPLET: EACH CELL MUST BE THE AVERAGE OF vofi_Get_cc AT THE TIME NODES,   *
+ * THE TOTAL VOLUME THE CONSTANT ONE OF THE DROPLET; THE LIPSCHITZ BOUNDS IN  *
+ * SPACE AND TIME MUST GIVE THE SAME VALUES WITH FEWER EVALUATIONS            *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  vofi_opts opts = {0};
+  int itrue,i,j,k,n,nerr;
+  vofi_real x0[NDIM],xloc[NDIM];
+  cnt_data cnt,cnl,cnf;
+  double h0,fh,t0,t1,tn,cc,cl,cs,vol_n;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function averaged over the time step [t0,t1] * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  t0 = 0.;
+  t1 = 1.;
+  itrue = 1;
+
+  /* Lipschitz bounds in the unit cube: |grad f| <= 2*sqrt(3), |df/dt| <= 2*UX*sqrt(3) */
+  opts.lip = 2.*sqrt(3.);
+  opts.lipt = 2.*UX*sqrt(3.);
+
+  /* starting point to get fh, at t = 0 */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+  cnf.t = 0.;
+  fh = vofi_Get_fh(fixed_func,&cnf,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+
+  nerr = 0;
+  vol_n = 0.;
+  cnt.nf = cnl.nf = cnf.nf = 0;
+  for (k=0;k<NMZ;k++)
+    for (j=0;j<NMY;j++) 
+      for (i=0;i<NMX;i++) {
+	xloc[0] = x0[0] + i*h0;
+	xloc[1] = x0[1] + j*h0;
+	xloc[2] = x0[2] + k*h0;
+	cc = vofi_Get_cc_time(time_func,&cnt,xloc,h0,fh,ndim0,t0,t1,NPT,NULL);
+	cl = vofi_Get_cc_time(time_func,&cnl,xloc,h0,fh,ndim0,t0,t1,NPT,&opts);
+	cs = 0.;
+	if (cc > 0. && cc < 1.)             /* sampled vofi_Get_cc at the time nodes */
+	  for (n=0;n<NPT;n++) {
+	    tn = 0.5*(t0 + t1) + 0.5*(t1 - t0)*xgl[n];
+	    cnf.t = tn;
+	    cs += 0.5*wgl[n]*vofi_Get_cc(fixed_func,&cnf,xloc,h0,fh,ndim0);
+	  }
+	else
+	  cs = cc;
+	if (fabs(cc - cs) > TOLT || fabs(cc - cl) > TOLT)
+	  nerr++;
+	vol_n += cc;
+      }
+  vol_n = vol_n*h0*h0*h0;
+
+  fprintf(stdout,"cells different from vofi_Get_cc at the time nodes or with the bounds: %d\n",
+	  nerr);
+  fprintf(stdout,"evaluations without the Lipschitz bounds: %ld\n",cnt.nf);
+  fprintf(stdout,"evaluations with the Lipschitz bounds   : %ld\n\n",cnl.nf);
+
+  check_volume(vol_n);
+
+  return (nerr == 0 && cnl.nf < cnt.nf) ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define TOLW  1.0e-13
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE WARM START OF THE INTERNAL LIMITS (opts.warm): THE    *
+ * VALUES MUST BE THOSE OF THE DEFAULT SEARCH UP TO ROUND-OFF, WITH FEWER     *
+ * EVALUATIONS OF THE IMPLICIT FUNCTION                                       *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,nerr;
+  long int m;
+  vofi_real *cc0,*ccw,x0[NDIM];
+  vofi_grid grid;
+  vofi_opts opts = {0};
+  vofi_stats st0,stw;
+  double h0,fh,vol_0,vol_w,dmax;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with local Gauss integration          *
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  cc0 = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  ccw = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  if (cc0 == NULL || ccw == NULL) {
+    fprintf(stderr,"Out of memory\n");
+    return 1;
+  }
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+  grid.opts = &opts;
+
+  /* default search of the internal limits */
+  st0.nfunc = st0.nsave = 0;
+  opts.stats = &st0;
+  vol_0 = vofi_Get_cc_grid(impl_func,NULL,&grid,fh,cc0);
+
+  /* warm start from the previous planes */
+  stw.nfunc = stw.nsave = 0;
+  opts.stats = &stw;
+  opts.warm = 1;
+  vol_w = vofi_Get_cc_grid(impl_func,NULL,&grid,fh,ccw);
+
+  dmax = 0.;
+  for (m=0;m<NMX*NMY*NMZ;m++)
+    if (fabs(ccw[m]-cc0[m]) > dmax)
+      dmax = fabs(ccw[m]-cc0[m]);
+  nerr = 0;
+  if (dmax > TOLW || stw.nfunc >= st0.nfunc)
+    nerr++;
+  fprintf(stdout,"default search: %ld evaluations\n",st0.nfunc);
+  fprintf(stdout,"warm start    : %ld evaluations, largest difference: %9.2e\n\n",
+	  stw.nfunc,dmax);
+
+  check_volume(vol_w);
+  if (fabs(vol_w - vol_0) > TOLW)
+    nerr++;
+
+  free(cc0);
+  free(ccw);
+
+  return (nerr == 0) ? 0 : 1;
+}
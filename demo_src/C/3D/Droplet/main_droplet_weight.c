@@ -0,0 +1,103 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "droplet.h"
+
+#define NDIM  3
+#define N3D   3
+#define NPR   4
+#define TOLW  1.0e-12
+
+extern void check_volume(vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * weight function, a density profile g(x,y,z) = 1 + x + y^2                  *
+ * -------------------------------------------------------------------------- */
+
+vofi_real weight_func(void *wdata,vofi_creal xy[])
+{
+  return 1. + xy[0] + xy[1]*xy[1];
+}
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE INTEGRAL OF A WEIGHT FUNCTION OVER THE REFERENCE      *
+ * PHASE, COMPUTED IN THE SAME PASS OF THE VOLUME FRACTION: THE VOLUME        *
+ * FRACTION MUST BE THAT OF vofi_Get_cc AND THE TOTAL INTEGRAL THE EXACT ONE  *
+ * OF THE DROPLET, V*(1 + XC + YC^2 + R0^2/5)                                 *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,i,j,k,nerr;
+  vofi_real x0[NDIM],xloc[NDIM];
+  double h0,fh,cc,wc,vol_n,wint_n,wint_a;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function and of the integral of the weight    * 
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(impl_func,NULL,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+
+  nerr = 0;
+  vol_n = wint_n = 0.;
+  for (k=0;k<NMZ;k++)
+    for (j=0;j<NMY;j++) 
+      for (i=0;i<NMX;i++) {
+	xloc[0] = x0[0] + i*h0;
+	xloc[1] = x0[1] + j*h0;
+	xloc[2] = x0[2] + k*h0;
+	cc = vofi_Get_cc_weight(impl_func,NULL,xloc,h0,fh,ndim0,weight_func,NULL,NPR,&wc);
+	if (cc != vofi_Get_cc(impl_func,NULL,xloc,h0,fh,ndim0))
+	  nerr++;
+	vol_n += cc;
+	wint_n += wc;
+      }
+  vol_n = vol_n*h0*h0*h0;
+  wint_a = 4.*MYPI*R0*R0*R0/3.*(1. + XC + YC*YC + R0*R0/5.);
+
+  fprintf(stdout,"cells with a volume fraction different from vofi_Get_cc: %d\n",nerr);
+  fprintf(stdout,"analytical integral of the weight: %23.16e\n",wint_a);
+  fprintf(stdout,"numerical  integral of the weight: %23.16e\n",wint_n);
+  fprintf(stdout,"relative error                   : %23.16e\n\n",
+	  fabs(wint_n - wint_a)/wint_a);
+
+  check_volume(vol_n);
+
+  return (nerr == 0 && fabs(wint_n - wint_a) < TOLW*wint_a) ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "vofi.h"
+
+#define NDIM  3
+#define N3D   3
+#define NS    32
+#define TF    0.6
+#define AF    0.3
+#define TOLS  1.0e-10
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function of a flat film of thickness TF*h0, h0 = 1/NS, tilted by  *
+ * the angle AF around the y axis and centred in (0.5,0.5,0.5) of the unit    *
+ * cube: f = (n.(x-xc))^2 - (TF*h0/2)^2, n = (sin(AF),0,cos(AF))              *
+ * -------------------------------------------------------------------------- */
+
+vofi_real film_func(void *fdata,vofi_creal xy[])
+{
+  vofi_real s,t2;
+
+  s = sin(AF)*(xy[0]-0.5) + cos(AF)*(xy[2]-0.5);
+  t2 = 0.5*TF/NS;
+
+  return s*s - t2*t2;
+}
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE SPLIT OF THE CUT CELLS (opts.split) WITH A FILM       *
+ * THINNER THAN A CELL: BOTH SIDES OF THE FILM CROSS THE SAME CELLS AND THE   *
+ * INTERFACE IS NOT A SINGLE GRAPH ALONG ANY DIRECTION                        *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint ndim0=N3D;
+  int i,j,k,itrue;
+  vofi_real x0[NDIM],xloc[NDIM];
+  vofi_opts opts = {0};
+  double h0,fh,vol_n,vol_0,vol_a,err_n,err_0;
+
+  h0 = 1./NS;
+  itrue = 1;
+  opts.split = 1;
+
+  /* get the characteristic value fh on the lower side of the film */
+  x0[0] = 0.5;
+  x0[1] = 0.5;
+  x0[2] = 0.5 - 0.5*TF*h0/cos(AF);
+  fh = vofi_Get_fh(film_func,NULL,x0,h0,ndim0,itrue);
+
+  /* the cells near the film with and without the split */
+  vol_n = vol_0 = 0.;
+  for (i=0;i<NS;i++)
+    for (j=0;j<NS;j++)
+      for (k=0;k<NS;k++) {
+	xloc[0] = i*h0;
+	xloc[1] = j*h0;
+	xloc[2] = k*h0;
+	vol_n += vofi_Get_cc_opt(film_func,NULL,xloc,h0,fh,ndim0,&opts);
+	vol_0 += vofi_Get_cc(film_func,NULL,xloc,h0,fh,ndim0);
+      }
+  vol_n = vol_n*h0*h0*h0;
+  vol_0 = vol_0*h0*h0*h0;
+  vol_a = TF*h0/cos(AF);
+  err_n = fabs(vol_n - vol_a)/vol_a;
+  err_0 = fabs(vol_0 - vol_a)/vol_a;
+
+  fprintf(stdout,"film of thickness %.1f h0 tilted by %.1f rad in a %dX%dX%d grid\n",
+	  TF,AF,NS,NS,NS);
+  fprintf(stdout,"analytical volume   : %23.16e\n",vol_a);
+  fprintf(stdout,"volume with split   : %23.16e, relative error: %9.2e\n",vol_n,err_n);
+  fprintf(stdout,"volume without split: %23.16e, relative error: %9.2e\n",vol_0,err_0);
+
+  return (err_n < TOLS) ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "quadric.h"
+
+#define NDIM  3
+#define N3D   3
+#define TOLV  1.0e-12
+#define TOLC  1.0e-10
+
+extern void set_quadric(vofi_quadric *);
+extern void check_volume(vofi_creal,vofi_creal);
+extern vofi_real impl_func(void *,vofi_creal []);
+
+/* -------------------------------------------------------------------------- *
+ * PROGRAM TO CHECK THE FAST PATH OF QUADRIC IMPLICIT FUNCTIONS: THE VOLUME   *
+ * FRACTION OF A ROTATED ELLIPSOID IS COMPUTED WITH vofi_Get_quadric AND      *
+ * COMPARED WITH THE EXACT VOLUME AND, CELL BY CELL, WITH THE VALUES OF THE   *
+ * GENERAL ALGORITHM FOR THE SAME FUNCTION                                    *
+ * -------------------------------------------------------------------------- */
+
+int main()
+{
+  vofi_cint nc[NDIM]={NMX,NMY,NMZ},ndim0=N3D;
+  int itrue,i;
+  vofi_real *ccq,*ccg,x0[NDIM];
+  vofi_grid grid;
+  vofi_quadric quad;
+  double h0,fh,vol_q,vol_a,dcc;
+
+/* -------------------------------------------------------------------------- *
+ * initialization of the color function with the quadric heights              *
+ * -------------------------------------------------------------------------- */
+   
+  h0 = H/nc[0];                                               /* grid spacing */
+  itrue = 1;
+  ccq = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  ccg = (vofi_real *) malloc(sizeof(vofi_real)*NMX*NMY*NMZ);
+  set_quadric(&quad);
+
+  /* starting point to get fh */
+  x0[0] = 0.5;
+  x0[1] = 0.5; 
+  x0[2] = 0.5; 
+
+  /* get the characteristic value fh of the implicit function */
+  fh = vofi_Get_fh(vofi_Get_quadric,&quad,x0,h0,ndim0,itrue);
+ 
+  /* put now starting point in (X0,Y0,Z0) to define the grid */
+  x0[0] = X0; 
+  x0[1] = Y0; 
+  x0[2] = Z0; 
+  vofi_Set_grid(&grid,x0,h0,nc,ndim0);
+
+  /* fast path, the drivers recognize the function vofi_Get_quadric */
+  vol_q = vofi_Get_cc_grid(vofi_Get_quadric,&quad,&grid,fh,ccq);
+
+  /* general algorithm with the same function */
+  vofi_Get_cc_grid(impl_func,&quad,&grid,fh,ccg);
+
+  dcc = 0.;
+  for (i=0;i<NMX*NMY*NMZ;i++)
+    dcc = (fabs(ccq[i]-ccg[i]) > dcc) ? fabs(ccq[i]-ccg[i]) : dcc;
+
+  check_volume(vol_q,dcc);
+
+  free(ccq);
+  free(ccg);
+
+  vol_a = 4.*MYPI*A1*B1*C1/3.;
+  return (fabs(vol_q-vol_a) < TOLV && dcc < TOLC) ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "vofi.h"
+#include "quadric.h"
+
+typedef const double creal;
+typedef const int cint;
+typedef double real;
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION (reference phase where f(x,y,z) < 0):                          *
+ * coefficients of a rotated ellipsoid inside the cube [0,1]x[0,1]x[0,1]      *
+ * f(x) = (x-xc)^T R D R^T (x-xc) - 1, D = diag(1/A1^2,1/B1^2,1/C1^2),        *
+ * R = Rz(ALPHA) Ry(BETA) Rx(GAMMA)                                           *
+ * INPUT PARAMETERS:                                                          *
+ * (XC,YC,ZC) center of the ellipsoid; A1,B1,C1: its semi-axes;               *
+ * ALPHA,BETA,GAMMA: rotation angles                                          *
+ * OUTPUT:                                                                    *
+ * q: coefficients of the quadric f(x) = x^T a x + b^T x + c                  *
+ * -------------------------------------------------------------------------- */
+
+void set_quadric(vofi_quadric *q)
+{
+  double rz[3][3],ry[3][3],rx[3][3],rt[3][3],r[3][3],d[3],xc[3];
+  int i,j,k;
+
+  d[0] = 1./(A1*A1);
+  d[1] = 1./(B1*B1);
+  d[2] = 1./(C1*C1);
+  xc[0] = XC;
+  xc[1] = YC;
+  xc[2] = ZC;
+
+  for (i=0;i<3;i++)
+    for (j=0;j<3;j++)
+      rz[i][j] = ry[i][j] = rx[i][j] = (i == j) ? 1. : 0.;
+  rz[0][0] = rz[1][1] = cos(ALPHA);
+  rz[1][0] = sin(ALPHA);
+  rz[0][1] = -rz[1][0];
+  ry[0][0] = ry[2][2] = cos(BETA);
+  ry[0][2] = sin(BETA);
+  ry[2][0] = -ry[0][2];
+  rx[1][1] = rx[2][2] = cos(GAMMA);
+  rx[2][1] = sin(GAMMA);
+  rx[1][2] = -rx[2][1];
+
+  for (i=0;i<3;i++)
+    for (j=0;j<3;j++) {
+      rt[i][j] = 0.;
+      for (k=0;k<3;k++)
+	rt[i][j] += rz[i][k]*ry[k][j];
+    }
+  for (i=0;i<3;i++)
+    for (j=0;j<3;j++) {
+      r[i][j] = 0.;
+      for (k=0;k<3;k++)
+	r[i][j] += rt[i][k]*rx[k][j];
+    }
+
+  for (i=0;i<3;i++)
+    for (j=0;j<3;j++) {
+      q->a[i][j] = 0.;
+      for (k=0;k<3;k++)
+	q->a[i][j] += r[i][k]*d[k]*r[j][k];
+    }
+  q->c = -1.;
+  for (i=0;i<3;i++) {
+    q->b[i] = 0.;
+    for (j=0;j<3;j++) {
+      q->b[i] -= 2.*q->a[i][j]*xc[j];
+      q->c += q->a[i][j]*xc[i]*xc[j];
+    }
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * the same quadric as a generic implicit function, the volume fraction is    *
+ * then computed with the general algorithm of the library                    *
+ * -------------------------------------------------------------------------- */
+
+real impl_func(void *userdata,creal xy[])
+{
+  return vofi_Get_quadric(userdata,xy);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void check_volume(creal vol_n,creal dcc)
+{
+  double vol_a;
+
+  vol_a = 4.*MYPI*A1*B1*C1/3.;
+
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"------------------ C: ellipsoid check with the quadric fast path -------------------\n");
+  fprintf (stdout," * rotated ellipsoid inside the cube [%.1f,%.1f]x[%.1f,%.1f]x[%.1f,%.1f] in a %dX%dX%d grid *\n", X0, X0+H, Y0, Y0+H, Z0, Z0+H, NMX, NMY, NMZ);
+  fprintf (stdout," * f(x) = (x-xc)^T R D R^T (x-xc) - 1, D = diag(1/A1^2,1/B1^2,1/C1^2)               *\n");
+  fprintf (stdout," * PARAMETERS:                                                                     *\n");
+  fprintf (stdout," * A1,B1,C1: semi-axes; (XC,YC,ZC) center; R = Rz(ALPHA) Ry(BETA) Rx(GAMMA)        *\n");
+  fprintf (stdout,"------------------------------------------------------------------------------------\n");
+  fprintf (stdout,"a1:    %23.16e\n",A1);
+  fprintf (stdout,"b1:    %23.16e\n",B1);
+  fprintf (stdout,"c1:    %23.16e\n",C1);
+  fprintf (stdout,"xc:    %23.16e\n",XC);
+  fprintf (stdout,"yc:    %23.16e\n",YC);
+  fprintf (stdout,"zc:    %23.16e\n",ZC);
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"analytical volume: %23.16e\n",vol_a);
+  fprintf (stdout,"numerical  volume: %23.16e\n\n",vol_n);
+  fprintf (stdout,"absolute error   : %23.16e\n",fabs(vol_a-vol_n));
+  fprintf (stdout,"relative error   : %23.16e\n",fabs(vol_a-vol_n)/vol_a); 
+  fprintf (stdout,"max cell difference with the general algorithm: %23.16e\n",dcc);
+  fprintf (stdout,"----------------- C: end quadric check --------------------\n");
+  fprintf (stdout,"-----------------------------------------------------------\n");
+  fprintf (stdout,"\n");
+
+  return;
+}
@@ -0,0 +1,45 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/* grid resolution */
+#define NMX   32
+#define NMY   32
+#define NMZ   32
+
+/* computational box */
+#define X0  0.0
+#define Y0  0.0
+#define Z0  0.0
+#define  H  1.0
+
+#define  MYPI   3.141592653589793238462643
+
+/* semi-axes of the ellipsoid */
+#define  A1      0.30
+#define  B1      0.20
+#define  C1      0.15
+
+/* center of the ellipsoid */
+#define  XC      0.5123
+#define  YC      0.4871
+#define  ZC      0.5031
+
+/* rotation angles around the z, y and x axes */
+#define  ALPHA   0.3
+#define  BETA    0.5
+#define  GAMMA   0.7
@@ -0,0 +1,3 @@
+#!/bin/sh
+# run the MPI droplet test on two ranks
+exec ${MPIEXEC:-mpiexec} -n 2 ./droplet_mpi_c
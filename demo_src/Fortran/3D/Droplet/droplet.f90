@@ -0,0 +1,85 @@
+!****************************************************************************
+!* Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+!* Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+!* (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+!*     Via dei Colli 16, 40136 Bologna, Italy                               *
+!* (b) Physics Department, Cooper Union, New York, NY, USA                  *
+!* (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+!*     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+!* (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+!*     Paris, France                                                        *
+!*                                                                          *
+!* You should have received a copy of the CPC license along with Vofi.      *
+!* If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+!*                                                                          *
+!* e-mail: ruben.scardovelli@unibo.it                                       *
+!*                                                                          *
+!****************************************************************************
+
+!* -------------------------------------------------------------------------- *
+!* DESCRIPTION (reference phase where f(x,y,z) < 0):                          *
+!* small spherical droplet inside the cube [0,1]x[0,1]x[0,1]                  *
+!* f(x,y,z) = (x-XC)^2 + (y-YC)^2 + (z-ZC)^2 - R0^2                           *
+!* PARAMETERS:                                                                *
+!* (xc,yc,zc) center of the droplet; r0: its radius                           *
+!* -------------------------------------------------------------------------- *
+
+MODULE DROPLET_MOD
+
+  USE, INTRINSIC :: ISO_C_BINDING
+
+  IMPLICIT NONE
+
+  REAL(8), PARAMETER :: mypi = 3.141592653589793238462643D0
+  REAL(8), PARAMETER :: r0 = 0.1D0
+  REAL(8), PARAMETER :: xc = 0.43D0, yc = 0.51D0, zc = 0.47D0
+
+  CONTAINS
+
+REAL(C_DOUBLE) FUNCTION IMPL_FUNC(userdata, xyz) BIND(C)
+
+  TYPE(C_PTR), VALUE :: userdata
+  REAL(C_DOUBLE), DIMENSION(3), INTENT(IN) :: xyz
+
+  IMPL_FUNC = (xyz(1) - xc)**2 + (xyz(2) - yc)**2 + (xyz(3) - zc)**2 - r0*r0
+
+  RETURN
+
+END FUNCTION IMPL_FUNC
+
+!* -------------------------------------------------------------------------- *
+
+SUBROUTINE CHECK_VOLUME(volnum,nx,ny,nz)
+
+  REAL(8),INTENT(IN) :: volnum
+  INTEGER,INTENT(IN) :: nx,ny,nz
+
+  REAL(8) :: volana
+
+  INTRINSIC DABS
+
+  volana = 4.D0*mypi*r0*r0*r0/3.D0
+
+  write(*,*) '-----------------------------------------------------------'
+  write(*,*) '------ F: droplet check with the array interface ----------'
+  write(*,104) nx,ny,nz
+  write(*,*) ' * section with ghost cells of a larger array, blocks of'
+  write(*,*) '   8X8X8 cells, two threads'
+  write(*,*) '-----------------------------------------------------------'
+  write(*,100) volana
+  write(*,101) volnum
+  write(*,*) ' '
+  write(*,102) DABS(volnum-volana)
+  write(*,103) DABS(volnum-volana)/volana
+  write(*,*) '------------------ F: end droplet check -------------------'
+  write(*,*) '-----------------------------------------------------------'
+  write(*,*) ' '
+  100 FORMAT(' analytical volume: ', ES23.16)
+  101 FORMAT(' numerical  volume: ', ES23.16)
+  102 FORMAT(' absolute error   : ', ES23.16)
+  103 FORMAT(' relative error   : ', ES23.16)
+  104 FORMAT('  * droplet inside the cube [0,1]x[0,1]x[0,1] in a ',I0,'X',I0,'X',I0,' grid')
+
+END SUBROUTINE CHECK_VOLUME
+
+END MODULE DROPLET_MOD
@@ -0,0 +1,58 @@
+!****************************************************************************
+!* Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+!* Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+!* (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+!*     Via dei Colli 16, 40136 Bologna, Italy                               *
+!* (b) Physics Department, Cooper Union, New York, NY, USA                  *
+!* (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+!*     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+!* (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+!*     Paris, France                                                        *
+!*                                                                          *
+!* You should have received a copy of the CPC license along with Vofi.      *
+!* If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+!*                                                                          *
+!* e-mail: ruben.scardovelli@unibo.it                                       *
+!*                                                                          *
+!****************************************************************************
+
+PROGRAM DROPLET
+
+  USE, INTRINSIC :: ISO_C_BINDING
+  USE VOFI_MOD
+  USE DROPLET_MOD
+
+  IMPLICIT NONE
+
+  INTEGER, PARAMETER :: NMX = 64, NMY = 64, NMZ = 64, NG = 1, NBX = 8
+  INTEGER, PARAMETER :: N3D = 3
+  REAL(8), PARAMETER :: X0 = 0.D0, Y0 = 0.D0, Z0 = 0.D0, H = 1.D0
+  REAL(8), DIMENSION(1-NG:NMX+NG,1-NG:NMY+NG,1-NG:NMZ+NG) :: cc
+  REAL(8), DIMENSION(3) :: xv
+  REAL(8) :: h0,fh,vol_n
+
+  ! *********************************************************************
+  ! PROGRAM TO INITIALIZE THE COLOR FUNCTION SCALAR FIELD OF THE INTERNAL
+  ! CELLS OF AN ARRAY WITH GHOST CELLS WITH A SINGLE CALL
+  ! *********************************************************************
+
+  h0 = H/NMX
+
+  ! starting point to get fh
+  xv(1) = 0.5D0; xv(2) = 0.5D0; xv(3) = 0.5D0
+  fh = vofi_get_fh_c(c_funloc(IMPL_FUNC),C_NULL_PTR,xv,h0,N3D,1)
+
+  ! minor vertex of the internal cell (1,1,1)
+  xv(1) = X0; xv(2) = Y0; xv(3) = Z0
+  cc = -1.D0
+  vol_n = vofi_get_cc_array(IMPL_FUNC,C_NULL_PTR,xv,h0,fh,cc(1:NMX,1:NMY,1:NMZ), &
+                            nblk=NBX,nthr=2)
+
+  ! the ghost cells must not be touched
+  IF (ANY(cc(0,:,:) /= -1.D0) .OR. ANY(cc(NMX+NG,:,:) /= -1.D0)) STOP 1
+  IF (ANY(cc(:,0,:) /= -1.D0) .OR. ANY(cc(:,NMY+NG,:) /= -1.D0)) STOP 1
+  IF (ANY(cc(:,:,0) /= -1.D0) .OR. ANY(cc(:,:,NMZ+NG) /= -1.D0)) STOP 1
+
+  CALL check_volume(vol_n,NMX,NMY,NMZ)
+
+END PROGRAM DROPLET
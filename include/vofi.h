@@ -47,6 +47,169 @@ typedef const double  vofi_creal;
 typedef double  vofi_real;
 typedef const int  vofi_cint;
 typedef double (*integrand) (void *,vofi_creal []);
+typedef void (*interval_integrand) (void *,vofi_creal [],vofi_creal [],vofi_real []);
+typedef double (*time_integrand) (void *,vofi_creal [],vofi_creal);
+
+/* counters of the function evaluations in the cells: nfunc: evaluations of 
+   the implicit function, nsave: evaluations saved by the point cache */
+typedef struct {
+  long int nfunc;
+  long int nsave;
+} vofi_stats;
+
+/* optional settings of the extended drivers, a zero (or NULL) field keeps 
+   the default behaviour of vofi_Get_cc;
+   lip: Lipschitz bound of the implicit function, |f(x)-f(y)| <= lip*|x-y|;
+   int_func: interval extension of the implicit function, given the box
+   [xlo,xhi] it returns a lower and an upper bound of f in fr[0] and fr[1];
+   stencil: if nonzero, the gradient in a cut cell is estimated with 
+   second-order differences of the f values on the 3x3(x3) local grid, 
+   instead of centred differences with extra evaluations;
+   cache: if nonzero, the f values in a cell are kept in a small cache, so
+   that the points shared by the different stages of the computation are
+   evaluated only once;
+   stats: if not NULL, the evaluations after the certified test are added
+   to its counters;
+   plane: if positive, tolerance of the test of a linear function in a cut
+   cell, the interface is then a plane and the volume fraction is computed
+   with the analytic relations of a plane and a cube, without any numerical
+   integration; the f values are compared with their linear fit and the 
+   error of the volume fraction is of the order of plane;
+   lipt: Lipschitz bound in time of a time-dependent implicit function, 
+   |f(x,t)-f(x,s)| <= lipt*|t-s|, with lip it certifies that a cell is 
+   either full or empty during a whole time step;
+   split: if nonzero, a cut cell where the interface is not a single graph
+   along the primary direction, or with many intersections with the sides
+   (e.g. a thin film or two small bubbles), is split into 2 (4, 8) subcells
+   of half size, down to two levels;
+   warm: if nonzero, in the external integration of a cut cell the single
+   intersection of a side with a plane is searched near the one 
+   extrapolated from the previous planes, with fewer evaluations; the 
+   volume fraction then differs from the default one at round-off */
+typedef struct {
+  vofi_real lip;
+  interval_integrand int_func;
+  int stencil;
+  int cache;
+  vofi_stats *stats;
+  vofi_real plane;
+  vofi_real lipt;
+  int split;
+  int warm;
+} vofi_opts;
+
+/* uniform grid of the whole-grid drivers: minor vertex x0, grid spacing h0,
+   number of cells nc along each direction (nc[2] is not used in 2D), space
+   dimension ndim, size nblk of the blocks of cells of the hierarchical
+   classification (nblk <= 1: cell by cell; fewer evaluations of f with
+   lip or int_func in opts), number nthr of OpenMP threads
+   that process the blocks (1 with vofi_Set_grid; nthr <= 0: OpenMP default;
+   with more than one thread the implicit function must be thread-safe), 
+   optional settings opts
+   (may be NULL); the volume fraction of cell (i,j,k) is
+   cc[i + nc[0]*(j + nc[1]*k)] */
+typedef struct {
+  vofi_real x0[3];
+  vofi_real h0;
+  int nc[3];
+  int ndim;
+  int nblk;
+  int nthr;
+  const vofi_opts *opts;
+} vofi_grid;
+
+/* sparse format of the volume fraction values of a grid: each row of cells
+   along x is split into runs, nrun in total, the runs of row r = j + nc[1]*k
+   are irow[r] <= n < irow[r+1], run n has rlen[n] cells with the value 
+   rval[n] = 0 (empty) or 1 (full), or it is a single cut cell (rval[n] = -1);
+   the ncut cut cells are listed in grid order, with the index 
+   icut[c] = i + nc[0]*(j + nc[1]*k) and the volume fraction ccut[c];
+   mrun and mcut are the allocated sizes of the arrays */
+typedef struct {
+  int nc[3];
+  int ndim;
+  long int nrun, mrun;
+  long int ncut, mcut;
+  long int *irow;
+  int *rlen;
+  signed char *rval;
+  long int *icut;
+  vofi_real *ccut;
+} vofi_sparse;
+
+/* interface of the cut cells of a grid, for the reconstruction of the 
+   polygons: the ncut cut cells are listed in grid order, with the index 
+   icut[c] = i + nc[0]*(j + nc[1]*k); the plane of cell c, with the volume
+   fraction of the cell, is n.(u - 1/2) + d = 0 in the normalized coordinates
+   u = (x - x_c)/h0 of the cell with minor vertex x_c, with the unit normal
+   n = pln[4c..4c+2] pointing out of the reference phase and d = pln[4c+3];
+   the intersections of the interface with the sides of the cell, ordered 
+   around the normal, are the points ipt[c] <= p < ipt[c+1], with the 
+   coordinates xpt[3p..3p+2]; mcut and mpt are the allocated sizes of the 
+   arrays */
+typedef struct {
+  int ndim;
+  long int ncut, mcut;
+  long int npt, mpt;
+  long int *icut;
+  vofi_real *pln;
+  long int *ipt;
+  vofi_real *xpt;
+} vofi_plic;
+
+/* quadric implicit function f(x) = x.a.x + b.x + c, the user data of 
+   vofi_Get_quadric; the drivers recognize this function and compute the
+   volume fraction of a cut cell with the exact heights of the quadric,
+   without any root search; in 2D the third row and column of the matrix a
+   and b[2] must be zero */
+typedef struct {
+  vofi_real a[3][3];
+  vofi_real b[3];
+  vofi_real c;
+} vofi_quadric;
+
+/* quadrature rules of the reference phase in a cell, computed together with
+   the volume fraction by vofi_Get_cc_rule in the arrays of the caller:
+   npr: number of Gauss-Legendre nodes along the heights of the interface 
+   and the sides of the full regions (4, 8, 12, 16 or 20, else 20); 
+   mvol, msrf: sizes of the arrays (number of nodes) of the volume and 
+   interface rules; nvol, nsrf: number of nodes of the two rules, the nodes 
+   beyond mvol, msrf are not stored;
+   xvol, wvol: nodes (three coordinates each, as the point x0 of the cell)
+   and weights of the volume rule, sum_n wvol[n]*g(xvol[3n]) is the integral 
+   of a field g over the reference phase of the cell;
+   xsrf, wsrf, vsrf: nodes, weights and unit normals (directed towards f > 0)
+   of the interface rule, sum_n wsrf[n]*g(xsrf[3n]) is the integral of g 
+   over the interface in the cell (length in 2D, area in 3D) */
+typedef struct {
+  int npr;
+  int mvol, nvol;
+  vofi_real *xvol;
+  vofi_real *wvol;
+  int msrf, nsrf;
+  vofi_real *xsrf;
+  vofi_real *wsrf;
+  vofi_real *vsrf;
+} vofi_rule;
+
+/* unstructured mesh of vofi_Get_cc_mesh: ndim: space dimension; nnod 
+   nodes with the coordinates xnod[3n..3n+2] (three also in 2D); nelm 
+   elements, the vertices of element e are the nodes ivrt[p], 
+   ielm[e] <= p < ielm[e+1], in the order of VTK: triangle (3 vertices) and
+   quadrilateral (4) in 2D, tetrahedron (4), pyramid (5), wedge (6) and
+   hexahedron (8) in 3D, with straight edges and bilinear faces, hence also
+   warped hexahedra; nthr: number of OpenMP threads (nthr <= 0: OpenMP 
+   default; with more than one thread the implicit function must be 
+   thread-safe) */
+typedef struct {
+  int ndim;
+  long int nnod;
+  const vofi_real *xnod;
+  long int nelm;
+  const long int *ielm;
+  const long int *ivrt;
+  int nthr;
+} vofi_mesh;
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,11 +237,380 @@ vofi_real vofi_Get_fh(integrand,void *,vofi_creal [],vofi_creal,vofi_cint,vofi_c
  * @param h0 grid spacing
  * @param fh characteristic function value
  * @param ndim0 space dimension
- * @param cc volume fraction value
+ * @return cc: volume fraction value, -1 if the limits of integration of a
+ * subcell of the last level (NLEV) do not fit in the internal arrays
  * @note C/C++ API
  */
 vofi_real vofi_Get_cc(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint);
 
+/**
+ * @brief Certify that a box (a cell or a block of cells) is either full or
+ * empty, with the interval extension or the Lipschitz bound of the implicit
+ * function.
+ * @param impl_func pointer to the implicit function
+ * @param opts optional settings with int_func and/or lip
+ * @param xlo minor vertex of the box
+ * @param hbox box sides
+ * @param ndim0 space dimension
+ * @return icc: full/empty box (1/0) or not certified (-1)
+ * @note C/C++ API
+ */
+int vofi_Get_cert(integrand,void *,const vofi_opts *,vofi_creal [],vofi_creal [],vofi_cint);
+
+/**
+ * @brief Same as vofi_Get_cc, but the cell is first classified with the
+ * certified test of vofi_Get_cert, when the optional settings allow it.
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param opts optional settings (NULL: same as vofi_Get_cc)
+ * @return cc volume fraction value
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_opt(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint,
+                          const vofi_opts *);
+
+/**
+ * @brief Initialize the grid structure of the whole-grid drivers with the
+ * default settings: blocks of 8 cells, a single thread, no optional settings.
+ * @param grid grid structure
+ * @param x0 minor vertex of the grid
+ * @param h0 grid spacing
+ * @param nc number of cells along each direction
+ * @param ndim0 space dimension
+ * @note C/C++ API
+ */
+void vofi_Set_grid(vofi_grid *,vofi_creal [],vofi_creal,vofi_cint [],vofi_cint);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of a grid, 
+ * blocks of cells are first classified as full or empty from coarse to
+ * fine, with the certified test or with the f values at the points of the
+ * local grids of all their cells, hence with the same values of a cell by
+ * cell computation, only the cells of the blocks that may be cut by the 
+ * interface are processed one by one.
+ * @note the evaluations of f scale with the interface, not with the grid,
+ * only with the certified test (lip or int_func in grid->opts); without it
+ * each block still evaluates f at about 2^d points per cell, the saving is
+ * then only in the integration of the full and empty cells.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param cc volume fraction values
+ * @return vol: total volume of the reference phase
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_grid(integrand,void *,const vofi_grid *,vofi_creal,vofi_real []);
+
+/**
+ * @brief Same as vofi_Get_cc_grid, but the volume fraction of cell (i,j,k)
+ * is cc[i*st[0] + j*st[1] + k*st[2]], e.g. for a section of a larger array,
+ * an array with ghost cells or a Fortran array section.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param st strides of the array cc along each direction (in values)
+ * @param cc volume fraction values
+ * @return vol: total volume of the reference phase
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_strided(integrand,void *,const vofi_grid *,vofi_creal,const long int [],
+                              vofi_real []);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of a grid, as
+ * vofi_Get_cc_grid, together with the apertures of all faces and, in 3D, 
+ * the wetted fractions of all edges, for cut-cell and embedded-boundary 
+ * solvers; each face (edge) is computed once, with the same algorithm of
+ * the volume fraction in 2D (on the side), and it is full or empty if one of
+ * its cells is full or empty; the edge cache of the grid sweep is kept, as
+ * in vofi_Get_plic, hence the zeroes on the sides already used by the
+ * integration are not searched again.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param cc volume fraction values, cc[i + nc[0]*(j + nc[1]*k)]
+ * @param af apertures af[jd] of the faces normal to direction jd, the face
+ * with minor vertex (i,j,k) is af[jd][i + nv[0]*(j + nv[1]*k)], with 
+ * nv = nc + 1 along jd and nv = nc along the other directions
+ * @param ae fractions ae[jd] of the edges along direction jd (3D only, may 
+ * be NULL), same indices with nv = nc along jd and nv = nc + 1 along the 
+ * other directions
+ * @return vol: total volume of the reference phase
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_apertures(integrand,void *,const vofi_grid *,vofi_creal,vofi_real [],
+                             vofi_real *[],vofi_real *[]);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of a grid, as
+ * vofi_Get_cc_grid, and the interface of each cut cell: the intersections 
+ * with the cell sides, taken from the edge cache of the grid sweep, hence 
+ * without a new search of the zeroes on the sides already used by the 
+ * integration, and a plane with the volume fraction of the cell.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param cc volume fraction values, cc[i + nc[0]*(j + nc[1]*k)]
+ * @param pl PLIC structure, to be released with vofi_Free_plic
+ * @return vol: total volume of the reference phase (-1 if out of memory)
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_plic(integrand,void *,const vofi_grid *,vofi_creal,vofi_real [],vofi_plic *);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of a grid, as
+ * vofi_Get_cc_grid, and the signed distance from the interface at the cell
+ * centres in a narrow band, for coupled level-set/VOF methods; the closest
+ * interface point of a cell centre among those of the nearby cut cells, 
+ * given by vofi_Get_plic, is refined with a zero search along the normal.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param nband width of the band: the cells within nband cells along each
+ * direction of a cut cell
+ * @param cc volume fraction values, cc[i + nc[0]*(j + nc[1]*k)]
+ * @param sd signed distance values, negative in the reference phase, same
+ * layout; outside the band sd = -dmax (full cells) or dmax (empty cells), 
+ * with dmax = (nband+1)*sqrt(ndim)*h0, the upper bound of |sd| in the band
+ * @return vol: total volume of the reference phase (-1 if out of memory)
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_sdf(integrand,void *,const vofi_grid *,vofi_creal,vofi_cint,vofi_real [],
+                          vofi_real []);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of a grid, 
+ * starting from a zero of the implicit function close to each seed point,
+ * only the cells connected through a face to a cut cell are processed one
+ * by one, all the other cells are set with a scan along the grid lines.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param nseed number of seed points, at least one for each connected 
+ * component of the interface (nseed=0: one seed in the center of the grid)
+ * @param xs coordinates of the seed points, xs[3*s+i] for seed s
+ * @param cc volume fraction values
+ * @return vol: total volume of the reference phase (-1 if out of memory)
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_front(integrand,void *,const vofi_grid *,vofi_creal,vofi_cint,vofi_creal [],
+                            vofi_real []);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of a grid and
+ * to write it to a file, slab by slab along the last direction (z in 3D),
+ * with bounded memory; the file has the same layout of the array cc of 
+ * vofi_Get_cc_grid (native byte order) and can be memory-mapped.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure, the slabs are nblk cells thick
+ * @param fh characteristic function value
+ * @param fname name of the output file, the number of completed planes is
+ * saved in the file fname.rst that is removed at the end
+ * @param irst restart switch (irst=1: restart from the planes completed in
+ * a previous call, if any; irst=0: start from scratch)
+ * @return vol: total volume of the reference phase (-1 if an I/O error
+ * has occurred)
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_file(integrand,void *,const vofi_grid *,vofi_creal,const char *,vofi_cint);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of a grid in a
+ * sparse format, with run-length encoded full/empty cells along each row
+ * and the list of the cut cells; the dense array is never allocated.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param sp sparse structure, to be released with vofi_Free_sparse
+ * @return vol: total volume of the reference phase (-1 if out of memory)
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_sparse(integrand,void *,const vofi_grid *,vofi_creal,vofi_sparse *);
+
+/**
+ * @brief Expand the sparse format into a dense array of volume fraction
+ * values, cc[i + nc[0]*(j + nc[1]*k)].
+ * @param sp sparse structure
+ * @param cc volume fraction values
+ * @note C/C++ API
+ */
+void vofi_Get_dense(const vofi_sparse *,vofi_real []);
+
+/**
+ * @brief Implicit function of a quadric, to be passed to the drivers together
+ * with its coefficients; a cut cell is then integrated with the exact 
+ * intersections of the quadric, falling back to the general algorithm only 
+ * in the degenerate cases (e.g. a parabolic cylinder in 3D).
+ * @param userdata pointer to a vofi_quadric structure
+ * @param xy point
+ * @return f(xy) = xy.a.xy + b.xy + c
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_quadric(void *,vofi_creal []);
+
+/**
+ * @brief Same as vofi_Get_cc, but the nodes and weights of the Gauss-Legendre
+ * quadratures of the cell are also returned, as a volume rule of the 
+ * reference phase and an interface rule, for the integration of other 
+ * fields; the weights are not normalized, their sum is the volume of the 
+ * reference phase in the cell (the area in 2D); the interface rule is less
+ * accurate where the interface is almost parallel to the primary direction
+ * of the integration, since the length (area) element is singular there.
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param rule quadrature rules, with the arrays given by the caller
+ * @return cc: volume fraction value
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_rule(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint,
+                           vofi_rule *);
+
+/**
+ * @brief Same as vofi_Get_cc, but the integral of a weight function (e.g. a
+ * density or a concentration profile) over the reference phase in the cell
+ * is also computed, with the same Gauss-Legendre quadratures of the volume
+ * fraction and npr nodes along the heights of the interface and the sides 
+ * of the full regions.
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param wfunc pointer to the weight function
+ * @param wdata user data of the weight function
+ * @param npr number of nodes along the heights (4, 8, 12, 16 or 20, else 20)
+ * @param wint integral of the weight function (not normalized)
+ * @return cc: volume fraction value
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_weight(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint,
+                             integrand,void *,vofi_cint,vofi_real *);
+
+/**
+ * @brief Driver to compute the volume fraction of the sub-cells of a 
+ * uniform refinement of a cell, with the hierarchical classification and
+ * the edge cache of the whole-grid driver, hence the limits along the sides
+ * shared by the sub-cells are computed once; the sub-cells sum to the 
+ * volume fraction of the cell, that of vofi_Get_cc to round-off, unless a 
+ * structure below the resolution of the cell is found in the sub-cells.
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param nref number of sub-cells along each direction (e.g. 2 or 4)
+ * @param ccs volume fraction values of the sub-cells, 
+ * ccs[i + nref*(j + nref*k)]
+ * @return cc: volume fraction value of the cell, the mean value of the 
+ * sub-cells
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_refine(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint,
+                             vofi_cint,vofi_real []);
+
+/**
+ * @brief Driver to compute the volume fraction of a cell averaged over the
+ * time step [t0,t1], for an implicit function f(x,t) of space and time, 
+ * with a Gauss-Legendre quadrature in time; with the Lipschitz bounds lip 
+ * and lipt of the optional settings a cell that is either full or empty 
+ * during the whole time step is certified with a single evaluation, else 
+ * at each time node.
+ * @note the single evaluation needs both lip and lipt: with lip alone each
+ * time node is certified with the test of vofi_Get_cert, without it each
+ * time node is classified with the local grid test, about 3^d evaluations
+ * of f per node also in a full or empty cell; int_func is not used, it has
+ * not the time argument.
+ * @param impl_func pointer to the implicit function of space and time
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param t0 initial time of the step
+ * @param t1 final time of the step
+ * @param npt number of Gauss-Legendre nodes in time (4, 8, 12, 16 or 20,
+ * else 20)
+ * @param opts optional settings (may be NULL)
+ * @return cc: volume fraction value averaged over the time step
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_time(time_integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint,
+                           vofi_creal,vofi_creal,vofi_cint,const vofi_opts *);
+
+/**
+ * @brief Driver to compute the volume fraction value of a two-dimensional
+ * cell of an axisymmetric (r-z) grid, weighted by the radius r: the ratio 
+ * of the integral of r over the reference phase to that over the cell, 
+ * computed in the same pass of the 2D area.
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param irad radial direction (0: r = x, 1: r = y), the radius must be 
+ * nonnegative
+ * @return cc: axisymmetric volume fraction value
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_axi(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint);
+
+/**
+ * @brief Driver to compute the volume fraction value of an element of an
+ * unstructured mesh, mapped onto a reference square (cube): the limits and the
+ * heights are computed as in a cell of a grid, with the Jacobian 
+ * determinant of the map as the weight of the integration; triangles and 
+ * tetrahedra, also the two of a pyramid, have an affine map onto a reference
+ * simplex, classified once and integrated in its triangular (tetrahedral)
+ * sections, wedges are split into three hexahedra.
+ * @param impl_func pointer to the implicit function
+ * @param xv vertices of the element (three coordinates each, in the order 
+ * of VTK)
+ * @param nv number of vertices: 3 (triangle), 4 (quadrilateral) in 2D and
+ * 4 (tetrahedron), 5 (pyramid), 6 (wedge), 8 (hexahedron) in 3D
+ * @param fh characteristic function value of the size of the element
+ * @param ndim0 space dimension
+ * @param vol area/volume of the element
+ * @return cc: volume fraction value (-1: not a supported element or no room
+ * for the limits)
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_elem(integrand,void *,vofi_creal [],vofi_cint,vofi_creal,vofi_cint,
+                           vofi_real *);
+
+/**
+ * @brief Driver to compute the volume fraction value of all elements of an
+ * unstructured mesh, with OpenMP threads.
+ * @param impl_func pointer to the implicit function
+ * @param mesh nodes and connectivity of the mesh
+ * @param fh characteristic function value of the size of the largest 
+ * elements
+ * @param cc volume fraction values (-1: not a supported element or no room
+ * for the limits)
+ * @param ve area/volume of the elements
+ * @return vol: total volume of the reference phase
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_mesh(integrand,void *,const vofi_mesh *,vofi_creal,vofi_real [],
+                           vofi_real []);
+
+/**
+ * @brief Release the arrays of the sparse structure.
+ * @param sp sparse structure
+ * @note C/C++ API
+ */
+void vofi_Free_sparse(vofi_sparse *);
+
+/**
+ * @brief Release the arrays of the PLIC structure.
+ * @param pl PLIC structure
+ * @note C/C++ API
+ */
+void vofi_Free_plic(vofi_plic *);
+
 #ifdef __cplusplus
 }
 #endif
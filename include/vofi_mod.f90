@@ -0,0 +1,188 @@
+!****************************************************************************
+!* Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+!* Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+!* (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+!*     Via dei Colli 16, 40136 Bologna, Italy                               *
+!* (b) Physics Department, Cooper Union, New York, NY, USA                  *
+!* (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+!*     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+!* (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+!*     Paris, France                                                        *
+!*                                                                          *
+!* You should have received a copy of the CPC license along with Vofi.      *
+!* If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+!*                                                                          *
+!* e-mail: ruben.scardovelli@unibo.it                                       *
+!*                                                                          *
+!****************************************************************************
+
+!* -------------------------------------------------------------------------- *
+!* DESCRIPTION:                                                               *
+!* Fortran 2003 module with the ISO_C_BINDING interface of the whole-grid     *
+!* drivers: the volume fraction of a whole 2D or 3D array, also an array      *
+!* section with non-unit strides, is computed with a single call of the       *
+!* generic function VOFI_GET_CC_ARRAY; the implicit function must have the    *
+!* interface VOFI_INTEGRAND (BIND(C), userdata passed by value)               *
+!* -------------------------------------------------------------------------- *
+
+MODULE VOFI_MOD
+
+  USE, INTRINSIC :: ISO_C_BINDING
+
+  IMPLICIT NONE
+
+  PRIVATE
+  PUBLIC :: vofi_grid, vofi_integrand, vofi_set_grid, vofi_get_fh_c
+  PUBLIC :: vofi_get_cc_strided, vofi_get_cc_array
+
+  ! same layout as the C structure vofi_grid
+  TYPE, BIND(C) :: vofi_grid
+    REAL(C_DOUBLE) :: x0(3)
+    REAL(C_DOUBLE) :: h0
+    INTEGER(C_INT) :: nc(3)
+    INTEGER(C_INT) :: ndim
+    INTEGER(C_INT) :: nblk
+    INTEGER(C_INT) :: nthr
+    TYPE(C_PTR) :: opts
+  END TYPE vofi_grid
+
+  ABSTRACT INTERFACE
+    REAL(C_DOUBLE) FUNCTION vofi_integrand(userdata,xyz) BIND(C)
+      IMPORT :: C_DOUBLE, C_PTR
+      TYPE(C_PTR), VALUE :: userdata
+      REAL(C_DOUBLE), DIMENSION(3), INTENT(IN) :: xyz
+    END FUNCTION vofi_integrand
+  END INTERFACE
+
+  INTERFACE
+    SUBROUTINE vofi_set_grid(grid,x0,h0,nc,ndim0) BIND(C,name='vofi_Set_grid')
+      IMPORT :: vofi_grid, C_DOUBLE, C_INT
+      TYPE(vofi_grid), INTENT(OUT) :: grid
+      REAL(C_DOUBLE), DIMENSION(3), INTENT(IN) :: x0
+      REAL(C_DOUBLE), VALUE :: h0
+      INTEGER(C_INT), DIMENSION(3), INTENT(IN) :: nc
+      INTEGER(C_INT), VALUE :: ndim0
+    END SUBROUTINE vofi_set_grid
+
+    REAL(C_DOUBLE) FUNCTION vofi_get_fh_c(impl_func,userdata,x0,h0,ndim0,ix0) &
+                   BIND(C,name='vofi_Get_fh')
+      IMPORT :: C_DOUBLE, C_INT, C_PTR, C_FUNPTR
+      TYPE(C_FUNPTR), VALUE :: impl_func
+      TYPE(C_PTR), VALUE :: userdata
+      REAL(C_DOUBLE), DIMENSION(3), INTENT(IN) :: x0
+      REAL(C_DOUBLE), VALUE :: h0
+      INTEGER(C_INT), VALUE :: ndim0, ix0
+    END FUNCTION vofi_get_fh_c
+
+    REAL(C_DOUBLE) FUNCTION vofi_get_cc_strided(impl_func,userdata,grid,fh,st,cc) &
+                   BIND(C,name='vofi_Get_cc_strided')
+      IMPORT :: vofi_grid, C_DOUBLE, C_LONG, C_PTR, C_FUNPTR
+      TYPE(C_FUNPTR), VALUE :: impl_func
+      TYPE(C_PTR), VALUE :: userdata
+      TYPE(vofi_grid), INTENT(IN) :: grid
+      REAL(C_DOUBLE), VALUE :: fh
+      INTEGER(C_LONG), DIMENSION(3), INTENT(IN) :: st
+      TYPE(C_PTR), VALUE :: cc
+    END FUNCTION vofi_get_cc_strided
+  END INTERFACE
+
+  INTERFACE vofi_get_cc_array
+    MODULE PROCEDURE vofi_get_cc_array_2d, vofi_get_cc_array_3d
+  END INTERFACE vofi_get_cc_array
+
+CONTAINS
+
+!* -------------------------------------------------------------------------- *
+!* DESCRIPTION:                                                               *
+!* volume fraction in all cells of a 2D array, cc(i,j) is the cell with       *
+!* minor vertex x0 + ((i-1)*h0,(j-1)*h0)                                      *
+!* INPUT: implicit function, userdata, minor vertex x0 of the grid, grid      *
+!* spacing h0, characteristic function value fh, optional block size nblk     *
+!* and number of threads nthr (see vofi_grid in vofi.h)                       *
+!* OUTPUT: cc: volume fraction values, total area of the reference phase      *
+!* -------------------------------------------------------------------------- *
+
+  REAL(C_DOUBLE) FUNCTION vofi_get_cc_array_2d(impl_func,userdata,x0,h0,fh,cc,nblk,nthr)
+
+    PROCEDURE(vofi_integrand) :: impl_func
+    TYPE(C_PTR), INTENT(IN) :: userdata
+    REAL(C_DOUBLE), DIMENSION(:), INTENT(IN) :: x0
+    REAL(C_DOUBLE), INTENT(IN) :: h0,fh
+    REAL(C_DOUBLE), DIMENSION(:,:), INTENT(INOUT), TARGET :: cc
+    INTEGER, INTENT(IN), OPTIONAL :: nblk,nthr
+
+    TYPE(vofi_grid) :: grid
+    INTEGER(C_INT), DIMENSION(3) :: nc
+    INTEGER(C_LONG), DIMENSION(3) :: st
+    REAL(C_DOUBLE), DIMENSION(3) :: xv
+
+    vofi_get_cc_array_2d = 0.0D0
+    IF (SIZE(cc) == 0) RETURN
+
+    nc(1) = SIZE(cc,1); nc(2) = SIZE(cc,2); nc(3) = 1
+    xv(1) = x0(1); xv(2) = x0(2); xv(3) = 0.0D0
+    st = 0
+    IF (nc(1) > 1) st(1) = vofi_get_stride(c_loc(cc(1,1)),c_loc(cc(2,1)))
+    IF (nc(2) > 1) st(2) = vofi_get_stride(c_loc(cc(1,1)),c_loc(cc(1,2)))
+
+    CALL vofi_set_grid(grid,xv,h0,nc,2)
+    IF (PRESENT(nblk)) grid%nblk = nblk
+    IF (PRESENT(nthr)) grid%nthr = nthr
+    vofi_get_cc_array_2d = vofi_get_cc_strided(c_funloc(impl_func),userdata,grid,fh,st, &
+                                               c_loc(cc(1,1)))
+
+  END FUNCTION vofi_get_cc_array_2d
+
+!* -------------------------------------------------------------------------- *
+!* DESCRIPTION:                                                               *
+!* volume fraction in all cells of a 3D array, cc(i,j,k) is the cell with     *
+!* minor vertex x0 + ((i-1)*h0,(j-1)*h0,(k-1)*h0)                             *
+!* INPUT and OUTPUT: see vofi_get_cc_array_2d                                 *
+!* -------------------------------------------------------------------------- *
+
+  REAL(C_DOUBLE) FUNCTION vofi_get_cc_array_3d(impl_func,userdata,x0,h0,fh,cc,nblk,nthr)
+
+    PROCEDURE(vofi_integrand) :: impl_func
+    TYPE(C_PTR), INTENT(IN) :: userdata
+    REAL(C_DOUBLE), DIMENSION(:), INTENT(IN) :: x0
+    REAL(C_DOUBLE), INTENT(IN) :: h0,fh
+    REAL(C_DOUBLE), DIMENSION(:,:,:), INTENT(INOUT), TARGET :: cc
+    INTEGER, INTENT(IN), OPTIONAL :: nblk,nthr
+
+    TYPE(vofi_grid) :: grid
+    INTEGER(C_INT), DIMENSION(3) :: nc
+    INTEGER(C_LONG), DIMENSION(3) :: st
+
+    vofi_get_cc_array_3d = 0.0D0
+    IF (SIZE(cc) == 0) RETURN
+
+    nc(1) = SIZE(cc,1); nc(2) = SIZE(cc,2); nc(3) = SIZE(cc,3)
+    st = 0
+    IF (nc(1) > 1) st(1) = vofi_get_stride(c_loc(cc(1,1,1)),c_loc(cc(2,1,1)))
+    IF (nc(2) > 1) st(2) = vofi_get_stride(c_loc(cc(1,1,1)),c_loc(cc(1,2,1)))
+    IF (nc(3) > 1) st(3) = vofi_get_stride(c_loc(cc(1,1,1)),c_loc(cc(1,1,2)))
+
+    CALL vofi_set_grid(grid,x0,h0,nc,3)
+    IF (PRESENT(nblk)) grid%nblk = nblk
+    IF (PRESENT(nthr)) grid%nthr = nthr
+    vofi_get_cc_array_3d = vofi_get_cc_strided(c_funloc(impl_func),userdata,grid,fh,st, &
+                                               c_loc(cc(1,1,1)))
+
+  END FUNCTION vofi_get_cc_array_3d
+
+!* -------------------------------------------------------------------------- *
+!* DESCRIPTION:                                                               *
+!* distance in array values between two elements of an array                  *
+!* -------------------------------------------------------------------------- *
+
+  INTEGER(C_LONG) FUNCTION vofi_get_stride(p1,p2)
+
+    TYPE(C_PTR), INTENT(IN) :: p1,p2
+    REAL(C_DOUBLE) :: x
+
+    vofi_get_stride = INT((TRANSFER(p2,0_C_INTPTR_T) - TRANSFER(p1,0_C_INTPTR_T))/ &
+                          C_SIZEOF(x),C_LONG)
+
+  END FUNCTION vofi_get_stride
+
+END MODULE VOFI_MOD
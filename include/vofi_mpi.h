@@ -0,0 +1,91 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * This file is part of Vofi.                                               *
+ * This is supplement to the papers:                                        *
+ * [1] S Bnà, S Manservisi, R Scardovelli, P Yecko, S Zaleski,              *
+ *     "Numerical integration of implicit functions for the initialization  *
+ *     of the VOF function", Computers & Fluids 113, 42-52,                 *
+ *     doi:10.1016/j.compfluid.2014.04.010                                  *
+ * [2] S Bnà, S Manservisi, R Scardovelli, P Yecko, S Zaleski,              *
+ *     "VOFI -- A library to initialize the volume fraction scalar field",  *
+ *     Computer Physics Communications, Computer Physics Communications,    *
+ *     2015, doi:10.1016/j.cpc.2015.10.026                                  *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file vofi_mpi.h
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief Prototypes for the MPI drivers of the vofi library, available 
+ *        only if the library has been configured with --enable-mpi.
+ */
+
+
+#ifndef VOFI_MPI_H
+#define VOFI_MPI_H
+
+#include <mpi.h>
+#include "vofi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Collective version of vofi_Get_fh: the characteristic function
+ * value is computed by rank 0 of the communicator from its starting point,
+ * then it is broadcast to all ranks, that get the same fh.
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point (only that of rank 0 is used)
+ * @param h0 grid spacing
+ * @param ndim0 space dimension
+ * @param ix0 switch for @p x0 (ix0=1: point x0 is given; ix0=0: use the default value for x0)
+ * @param comm MPI communicator
+ * @return fh "characteristic" function value
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_fh_mpi(integrand,void *,vofi_creal [],vofi_creal,vofi_cint,vofi_cint,MPI_Comm);
+
+/**
+ * @brief Driver to compute the volume fraction in all cells of the local 
+ * sub-box of a domain-decomposed grid, including ng ghost layers on each
+ * side, and the total volume of the reference phase in the whole domain.
+ * The global sum is done in fixed point, hence it does not depend on the
+ * number of ranks nor on the order of the reduction.
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure of the local sub-box, without ghost cells, 
+ * each rank uses grid->nthr OpenMP threads (one thread if nthr <= 0)
+ * @param ng number of ghost layers along each direction
+ * @param fh characteristic function value (the same on all ranks)
+ * @param comm MPI communicator
+ * @param cc volume fraction values, with the ghost cells, the cell (i,j,k)
+ * of the sub-box, -ng[n] <= i,j,k < nc[n]+ng[n], is at index 
+ * (i+ng[0]) + (nc[0]+2*ng[0])*((j+ng[1]) + (nc[1]+2*ng[1])*(k+ng[2]))
+ * @return vol: total volume of the reference phase in the whole domain,
+ * without ghost cells
+ * @note C/C++ API
+ */
+vofi_real vofi_Get_cc_mpi(integrand,void *,const vofi_grid *,vofi_cint [],vofi_creal,MPI_Comm,
+                          vofi_real []);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include "vofi.h"
 
 #ifdef __cplusplus
 #define Extern extern "C"
@@ -68,13 +69,27 @@
 #define NLSX     3
 #define NLSY     3
 #define NLSZ     3
-#define NSEG    10
+#define NSEG    16
+#define NCUT     4
+#define NLEV     2
+#define NPCH   256
+#define NEDG  1024
+#define NQSEG   24
+#define NQGL    20
+#define NQERR   16.
+#define NQSTK   32
+#define NPLC    24
+#define NPBIS  100
+#define NSDF    20
+#define NPAXI    4
+#define NMAP     8
+#define NPMAP    4
+#define NBLK     8
+#define NQUE    64
+#define NLIMB    6
+#define NLFR     4
 
-typedef double vofi_real;
-typedef const double vofi_creal;
-typedef const int vofi_cint;
 typedef int * const vofi_int_cpt;
-typedef double (*integrand) (void *,vofi_creal []);
 
 /* xval: coordinates of the minimum or where the sign has changed, fval: local
    function value, sval: distance from the starting point, if applicable,
@@ -96,11 +111,146 @@ typedef struct {
 } chk_data;
 
 /* icc: full/empty/cut cell (1/0/-1); ipt: tentative number of integration 
-   points; isb: number of subdivisions, not yet implemented (hence: 0/1) */
+   points; isb: number of subdivisions along each direction (0: full/empty 
+   cell, 1: cut cell, 2: with opts->split, the interface is not a single 
+   graph along the primary direction, split the cell); ipl: linear function in a cut cell
+   (1/0), pln: its gradient and center value in the normalized cell */
 typedef struct {
   int icc; int ipt; int isb;
+  int ipl; vofi_real pln[NDIM+1];
 } dir_data;
 
+/* single intersections of the two sides along the secondary direction with
+   the previous planes of the external integration of a rectangular 
+   hexahedron: nz: number of planes kept (0: search the whole side, at most
+   two), sz: position along the side, tz: coordinate of the plane along the
+   tertiary direction, fs: f value at the start of the side */
+typedef struct {
+  vofi_real sz[NEND][NEND];
+  vofi_real tz[NEND][NEND];
+  vofi_real fs[NEND];
+  int nz[NEND];
+} lim_data;
+
+/* point cache of a cell: user function impl_func and its data userdata, 
+   icache: use the cache (else only count), xc,fc: points and function 
+   values, ic: valid entry, nfunc: evaluations of the user function, nsave:
+   evaluations saved by the cache */
+typedef struct {
+  integrand impl_func;
+  void *userdata;
+  int icache;
+  vofi_real xc[NPCH][NDIM];
+  vofi_real fc[NPCH];
+  int ic[NPCH];
+  long int nfunc;
+  long int nsave;
+} pch_data;
+
+/* entry of the edge cache: key: edge (even) or face (odd) index plus one 
+   (0: free entry), cnt: number of threads that tried to take the free 
+   entry (the first one owns it), rdy: the values are ready, nz: number of
+   intersections or limits, sz: their distance from the minor vertex */
+typedef struct {
+  long int key;
+  int cnt;
+  int rdy;
+  int nz;
+  vofi_real sz[NEND];
+} edg_entry;
+
+/* edge cache of a sweep of the grid, with the intersections of the edges 
+   and the limits in the faces, shared by the threads: x0, h0: minor vertex
+   and spacing of the grid, nv: number of vertices along each direction, 
+   ne: size of the table (a power of 2, 0: no cache), nused: entries in 
+   use, nmiss: edges not kept because the table was full, nstep: largest
+   number of entries taken between two calls of vofi_age_edges, nlast: 
+   entries in use at the last call, nmax: largest size of a table, keep: 
+   keep all the edges (no eviction), tab: table, neo, old: size and table
+   of the previous generation (read only, 0 and NULL: none) */
+typedef struct {
+  vofi_real x0[NDIM];
+  vofi_real h0;
+  long int nv[NDIM];
+  long int ne;
+  long int nused;
+  long int nmiss;
+  long int nstep;
+  long int nlast;
+  long int nmax;
+  int keep;
+  edg_entry *tab;
+  long int neo;
+  edg_entry *old;
+} edg_data;
+
+/* zeroes of the quadratics that bound the smooth subdivisions of the 
+   heights (or of the areas) of a quadric: nz: number of zeroes, zr, zi: 
+   their real and imaginary parts (zi = 0: real zero), ns: number of limits
+   with a square root singularity, zs: their position */
+typedef struct {
+  int nz;
+  vofi_real zr[NQSEG];
+  vofi_real zi[NQSEG];
+  int ns;
+  vofi_real zs[NQSEG];
+} qdr_data;
+
+/* quadrature rules of a cell: rule: arrays of the caller (may be NULL); 
+   npr, xpr, wpr: Gauss-Legendre nodes and weights along the heights and the
+   sides of the full regions; wext: weight of the external integration (1 in
+   2D); ndim: space dimension; wfunc, wdata: weight function (may be NULL) 
+   and its data, wint: its integral over the reference phase; irad: radial
+   direction of the axisymmetric weight r = x[irad], integrated exactly 
+   along each column and added to wint (-1: no radial weight) */
+typedef struct {
+  vofi_rule *rule;
+  int ndim;
+  int npr;
+  vofi_creal *xpr;
+  vofi_creal *wpr;
+  vofi_real wext;
+  integrand wfunc;
+  void *wdata;
+  vofi_real wint;
+  int irad;
+} rul_data;
+
+/* implicit function restricted to the plane of a face: impl_func and 
+   userdata: user function and its data, ja, jb: directions of the two 
+   coordinates in the plane, jn: normal direction, xn: coordinate of the 
+   plane */
+typedef struct {
+  integrand impl_func;
+  void *userdata;
+  int ja; int jb; int jn;
+  vofi_real xn;
+} fac_data;
+
+/* implicit function at a given time: impl_func and userdata: user function
+   of space and time and its data, t: time */
+typedef struct {
+  time_integrand impl_func;
+  void *userdata;
+  vofi_real t;
+} tim_data;
+
+/* bilinear (trilinear) map of the square (cube) [0,hs]^ndim onto an 
+   element: impl_func and userdata: user function and its data, ndim: space
+   dimension, xv: vertices of the element at the corners (i,j,k) of the 
+   reference cell, xv[i + 2*j + 4*k], hs: side of the reference cell, the 
+   size of the element, so that the tolerances of the cell algorithm keep 
+   their meaning, ismp: affine map of a simplex, the corner of the reference
+   cell with sum(xi) <= hs (1/0) */
+typedef struct {
+  integrand impl_func;
+  void *userdata;
+  int ndim;
+  vofi_real xv[NMAP][NDIM];
+  vofi_real hs;
+  int ismp;
+} map_data;
+
 /* function prototypes */
 
 /* Fortran APIs */
@@ -133,6 +283,22 @@ vofi_real EXPORT(vofi_get_fh)(integrand,void *,vofi_creal [],vofi_creal *,vofi_c
 vofi_real EXPORT(vofi_get_cc)(integrand,void *,vofi_creal [],vofi_creal *,vofi_creal *,vofi_cint *);
 
 
+/**
+ * @brief Same as vofi_get_cc, but the cell is first classified with the
+ * Lipschitz bound of the implicit function.
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param lip Lipschitz bound of the implicit function (<= 0: not given)
+ * @return cc volume fraction value
+ * @note Fortran API
+ */
+vofi_real EXPORT(vofi_get_cc_lip)(integrand,void *,vofi_creal [],vofi_creal *,vofi_creal *,vofi_cint *,
+                                  vofi_creal *);
+
+
 /**
  * @brief compute the zero in a given segment of length s0, the zero is strictly
  * bounded, i.e. f(0)*f(s0) < 0.
@@ -200,11 +366,13 @@ chk_data vofi_check_face_consistency(integrand,void *,vofi_creal [],vofi_creal [
  * @param h0 grid spacing
  * @param fh characteristic function value
  * @param ndim0 space dimension
+ * @param opts optional settings (may be NULL)
  * @return icps: icc: full/empty/cut cell (1/0/-1); ipt: tentative number
- * of integration points; isb: number of subdivisions, not yet implemented
- * (hence: 0/1) 
+ * of integration points; isb: number of subdivisions along each direction
+ * (0/1/2); ipl, pln: linear function in a cut cell, with opts->plane
  */
-dir_data vofi_get_dirs(integrand,void *,vofi_creal [],vofi_real [],vofi_real [],vofi_real [],vofi_creal,vofi_creal,vofi_cint);
+dir_data vofi_get_dirs(integrand,void *,vofi_creal [],vofi_real [],vofi_real [],vofi_real [],vofi_creal,vofi_creal,vofi_cint,
+                       const vofi_opts *);
 
 
 /**
@@ -218,10 +386,81 @@ dir_data vofi_get_dirs(integrand,void *,vofi_creal [],vofi_real [],vofi_real [],
  * @param tdir tertiary direction
  * @param h0 grid spacing
  * @param stdir subdivision direction (2/3)
- * @param ndim0 space dimension
- * @return nsub: total number of subdivisions
+ * @param ped edge cache of the grid sweep (may be NULL)
+ * @return nsub: total number of subdivisions (-1: no room for the limits in
+ * lim_intg, NSEG values)
+ */
+int vofi_get_limits(integrand,void *,vofi_creal [],vofi_real [],vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal,vofi_cint,
+                    edg_data *);
+
+
+/**
+ * @brief same as vofi_get_limits along the secondary direction, for a plane 
+ * of the external integration of a rectangular hexahedron: a single 
+ * intersection of a side with the previous planes is searched near its 
+ * extrapolated position
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param lim_intg start/end of each subdivision (lim_intg[0] = 0, lim_intg[nsub] = h0)
+ * @param pdir primary direction
+ * @param sdir secondary direction
+ * @param h0 grid spacing
+ * @param t coordinate of the plane along the tertiary direction
+ * @param pld intersections of the previous planes, updated
+ * @return nsub: total number of subdivisions (-1: no room for the limits in
+ * lim_intg, NSEG values)
  */
-int vofi_get_limits(integrand,void *,vofi_creal [],vofi_real [],vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal,vofi_cint);
+int vofi_get_limits_inner(integrand,void *,vofi_creal [],vofi_real [],vofi_creal [],vofi_creal [],
+                          vofi_creal,vofi_creal,lim_data *);
+
+
+/**
+ * @brief same as vofi_get_limits, in the reference simplex {xi >= 0, 
+ * sum(xi) <= h0} of an affine map, whose columns along the primary direction
+ * end at the hypotenuse
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param lim_intg start/end of each subdivision (lim_intg[0] = 0, lim_intg[nsub] = h0)
+ * @param pdir primary direction
+ * @param sdir secondary direction
+ * @param tdir tertiary direction
+ * @param h0 side of the simplex
+ * @param stdir subdivision direction (2/3)
+ * @return nsub: total number of subdivisions (-1: no room for the limits in
+ * lim_intg, NSEG values)
+ */
+int vofi_get_limits_simplex(integrand,void *,vofi_creal [],vofi_real [],vofi_creal [],vofi_creal [],
+                            vofi_creal [],vofi_creal,vofi_cint);
+
+
+/**
+ * @brief position along the tertiary direction where the bottom side or the
+ * hypotenuse of the planes of the reference tetrahedron becomes tangent to 
+ * the interface, between two external limits
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param pdir primary direction
+ * @param sdir secondary direction
+ * @param tdir tertiary direction
+ * @param h0 side of the tetrahedron
+ * @param k side: bottom/hypotenuse (0/1)
+ * @param ta start of the interval
+ * @param tb end of the interval
+ * @return tz: position of the tangency (-1: no tangency is found)
+ */
+vofi_real vofi_get_simplex_tangent(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],
+                                   vofi_creal [],vofi_creal,vofi_cint,vofi_creal,vofi_creal);
+
+
+/**
+ * @brief order the limits of integration from 0 to h0 and remove the 
+ * zero-length intervals
+ * @param lim_intg start/end of each subdivision
+ * @param h0 grid spacing
+ * @param nsub number of subdivisions
+ * @return nsub: updated number of subdivisions
+ */
+int vofi_sort_limits(vofi_real [],vofi_creal,int);
 
 
 /**
@@ -234,11 +473,30 @@ int vofi_get_limits(integrand,void *,vofi_creal [],vofi_real [],vofi_creal [],vo
  * @param h0 grid spacing
  * @param nsub updated number of subdivisions
  * @param lim_intg updated start of new subdivisions
+ * @return ist: success/no room for two more limits and h0 (0/-1)
  */
-void vofi_get_side_intersections(integrand,void *,vofi_real [],vofi_creal [],vofi_real [],vofi_creal [],
+int vofi_get_side_intersections(integrand,void *,vofi_real [],vofi_creal [],vofi_real [],vofi_creal [],
 			    vofi_creal,vofi_int_cpt);
 
 
+/**
+ * @brief compute the single interface intersection with a given cell side,
+ * from a bracket around a guess of its position and the sign of f at the 
+ * start of the side
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param stdir direction
+ * @param h0 grid spacing
+ * @param sg guess of the intersection
+ * @param dg half-width of the bracket around the guess
+ * @param fs function value at the start of the side
+ * @param sz position of the intersection along the side
+ * @return ist: success/the sign at the start of the side has changed (0/-1)
+ */
+int vofi_get_side_zero(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal,vofi_creal,vofi_creal,
+                       vofi_creal,vofi_real *);
+
+
 /**
  * @brief get the external limits of integration that are inside the face.
  * these are new internal/external limits of integration.
@@ -250,8 +508,9 @@ void vofi_get_side_intersections(integrand,void *,vofi_real [],vofi_creal [],vof
  * @param h0 grid spacing
  * @param nsub updated number of subdivisions
  * @param lim_intg updated start of new subdivisions
+ * @return ist: success/no room for two more limits and h0 (0/-1)
  */
-void vofi_get_face_intersections(integrand,void *,min_data,vofi_creal [],vofi_real [],vofi_creal [],
+int vofi_get_face_intersections(integrand,void *,min_data,vofi_creal [],vofi_real [],vofi_creal [],
 			   vofi_creal [],vofi_creal,vofi_int_cpt);
 
 
@@ -288,6 +547,19 @@ min_data vofi_get_segment_min(integrand,void *,vofi_creal [],vofi_creal [],vofi_
 min_data vofi_get_face_min(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],chk_data,vofi_creal);
 
 
+/**
+ * @brief signed minimum of the function in a side: negative if f_sign*f 
+ * changes sign along the side, else the minimum of f_sign*f
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param dir direction
+ * @param h0 side length
+ * @param f_sign sign attribute
+ * @return fm: minimum of f_sign*f in the side, or a negative value of it
+ */
+vofi_real vofi_get_side_min(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal,vofi_cint);
+
+
 /**
  * @brief subdivide the side along the secondary/tertiary (2/3) direction to define
  * rectangles/rectangular hexahedra with or without the interface     
@@ -299,9 +571,11 @@ min_data vofi_get_face_min(integrand,void *,vofi_creal [],vofi_creal [],vofi_cre
  * @param h0 grid spacing
  * @param nintsub number of internal subdivisions
  * @param nintpt tentative number of internal integration points 
+ * @param prl quadrature rules of the cell (may be NULL)
  * @return area: normalized value of the cut area or 2D volume fraction
  */
-vofi_real vofi_get_area(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal,vofi_cint,vofi_cint);
+vofi_real vofi_get_area(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal,vofi_cint,vofi_cint,
+                        rul_data *);
 
 
 /**
@@ -315,11 +589,811 @@ vofi_real vofi_get_area(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal
  * @param h0 grid spacing
  * @param nextsub number of external subdivisions
  * @param nintpt tentative number of internal integration points
+ * @param iwarm warm start of the internal limits from the previous planes (1/0)
+ * @param prl quadrature rules of the cell (may be NULL)
  * @return vol: normalized value of the cut volume or 3D volume fraction
+ * (-1: no room for the internal limits of an external node)
  */
 vofi_real vofi_get_volume(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal,
-		  vofi_cint,vofi_cint);
+		  vofi_cint,vofi_cint,vofi_cint,rul_data *);
 
-#endif
 
+/**
+ * @brief same as vofi_get_area, in the reference triangle of an affine map,
+ * whose column at s along the primary direction has length h0 - s
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param int_lim_intg internal limits of integration
+ * @param pdir primary direction
+ * @param sdir secondary direction
+ * @param h0 side of the triangle
+ * @param nintsub number of internal subdivisions
+ * @param nintpt tentative number of internal integration points 
+ * @return area: cut area normalized with the area of the triangle
+ */
+vofi_real vofi_get_area_simplex(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],
+                                vofi_creal [],vofi_creal,vofi_cint,vofi_cint);
+
+
+/**
+ * @brief same as vofi_get_volume, in the reference tetrahedron of an affine
+ * map, whose plane at t is the triangle of side h0 - t
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param ext_lim_intg external limits of integration
+ * @param pdir primary direction
+ * @param sdir secondary direction
+ * @param tdir tertiary direction
+ * @param h0 side of the tetrahedron
+ * @param nextsub number of external subdivisions
+ * @param nintpt tentative number of internal integration points
+ * @return vol: cut volume normalized with the volume of the tetrahedron
+ * (-1: no room for the internal limits of an external node)
+ */
+vofi_real vofi_get_volume_simplex(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],
+                                  vofi_creal [],vofi_creal [],vofi_creal,vofi_cint,vofi_cint);
+
+
+/**
+ * @brief sample the implicit function in a block of cells at the points of 
+ * the local grids of vofi_get_dirs in all its cells and check if it is either
+ * full or empty, as each of its cells would be in vofi_get_dirs
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param ib indices of the first cell of the block
+ * @param nb number of cells of the block along each direction
+ * @param fh characteristic function value
+ * @return icc: full/empty/maybe cut block (1/0/-1)
+ */
+int vofi_get_block_class(integrand,void *,const vofi_grid *,vofi_cint [],vofi_cint [],vofi_creal);
+
+
+/**
+ * @brief classify a block of cells from coarse to fine, then compute the 
+ * volume fraction of the cells that may be cut by the interface
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param ib indices of the first cell of the block
+ * @param nb number of cells of the block along each direction
+ * @param st strides of the array cc along each direction
+ * @param m0 offset of the first value of the array cc
+ * @param cc volume fraction values of the grid
+ * @param ped edge cache of the grid sweep (may be NULL)
+ */
+void vofi_get_block(integrand,void *,const vofi_grid *,vofi_creal,vofi_cint [],vofi_cint [],
+                    const long int [],long int,vofi_real [],edg_data *);
+
+
+/**
+ * @brief compute the volume fraction in the slab k0 <= k < k0+nk of the grid
+ * along the last direction, with the same cell coordinates as for the whole
+ * grid
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param k0 first plane of the slab
+ * @param nk number of planes of the slab
+ * @param st strides of the array cc along each direction (NULL: contiguous)
+ * @param cc volume fraction values of the slab
+ * @return vol: volume of the reference phase in the slab
+ */
+vofi_real vofi_get_cc_slab(integrand,void *,const vofi_grid *,vofi_creal,vofi_cint,vofi_cint,
+                           const long int [],vofi_real []);
+
+
+/**
+ * @brief same as vofi_get_cc_slab, with the edge cache of the caller, that
+ * keeps the intersections of the edges of the grid after the sweep
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param k0 first plane of the slab
+ * @param nk number of planes of the slab
+ * @param st strides of the array cc along each direction (NULL: contiguous)
+ * @param cc volume fraction values of the slab
+ * @param ped initialized edge cache
+ * @return vol: volume of the reference phase in the slab
+ */
+vofi_real vofi_get_cc_edges(integrand,void *,const vofi_grid *,vofi_creal,vofi_cint,vofi_cint,
+                            const long int [],vofi_real [],edg_data *);
+
+
+/**
+ * @brief starting from point x0 get a zero of the implicit function, using
+ * gradient ascent/descent
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param xz zero of the implicit function
+ * @param ndim0 space dimension
+ * @return iz: found/not found (1/0)
+ */
+int vofi_get_interface_point(integrand,void *,vofi_creal [],vofi_real [],vofi_cint);
+
+
+/**
+ * @brief make room for one more cell in the queue of the front driver, by
+ * doubling its size
+ * @param queue queue of the cells to visit
+ * @param mq size of the queue
+ * @param nq number of cells in the queue
+ * @return ist: success/failure (0/-1)
+ */
+int vofi_get_queue_room(long int **,long int *,long int);
+
+
+/**
+ * @brief compute the volume fraction value in a given cell with the local
+ * grid test and the numerical integration; with opts->split a cut cell with
+ * an interface that is not a single graph along the primary direction or
+ * with more than NCUT intersections with the sides is split into 2 (4, 8)
+ * subcells, down to NLEV levels; a cell whose limits (also of an internal
+ * plane) do not fit in NSEG values is always split, or reported as a failure at the last level
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param opts optional settings (may be NULL)
+ * @param nlev level of the cell (0: cell of the grid)
+ * @param ped edge cache of the grid sweep (may be NULL)
+ * @param prl quadrature rules of the cell (may be NULL)
+ * @param icc full/empty/cut cell (1/0/-1)
+ * @return cc: volume fraction value (-1: no room for the limits)
+ */
+vofi_real vofi_get_cc_sub(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint,
+                          const vofi_opts *,vofi_cint,edg_data *,rul_data *,vofi_int_cpt);
+
+
+/**
+ * @brief compute the volume fraction value in a given cell, with the 
+ * certified test first if the optional settings allow it
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @param ndim0 space dimension
+ * @param opts optional settings (may be NULL)
+ * @param ped edge cache of the grid sweep (may be NULL)
+ * @param icc full/empty/cut cell (1/0/-1)
+ * @return cc volume fraction value
+ */
+vofi_real vofi_get_cc_cell(integrand,void *,vofi_creal [],vofi_creal,vofi_creal,vofi_cint,const vofi_opts *,
+                           edg_data *,vofi_int_cpt);
+
+
+/**
+ * @brief add a value to a fixed-point number of NLIMB limbs of 32 bits, 
+ * with NLFR limbs for the fractional part (MPI drivers only)
+ * @param fx fixed-point number
+ * @param val value to add
+ */
+void vofi_add_fixed(long long [],vofi_creal);
 
+
+/**
+ * @brief propagate the carries of a fixed-point number (MPI drivers only)
+ * @param fx fixed-point number
+ */
+void vofi_norm_fixed(long long []);
+
+
+/**
+ * @brief convert a normalized fixed-point number to a real value (MPI 
+ * drivers only)
+ * @param fx fixed-point number
+ * @return val: its value
+ */
+vofi_real vofi_get_fixed(const long long []);
+
+
+/**
+ * @brief write (iwr=1) or read (iwr=0) n bytes at a given offset of a file,
+ * retrying after partial transfers and interrupts
+ * @param fd file descriptor
+ * @param buf buffer
+ * @param n number of bytes
+ * @param offs offset in the file
+ * @param iwr write/read switch (1/0)
+ * @return ist: success/failure (0/-1)
+ */
+int vofi_get_file_io(int,void *,size_t,long long,vofi_cint);
+
+
+/**
+ * @brief make room for n more runs and n more cut cells in the sparse 
+ * structure
+ * @param sp sparse structure
+ * @param n number of new entries
+ * @return ist: success/failure (0/-1)
+ */
+int vofi_get_sparse_room(vofi_sparse *,long int);
+
+
+/**
+ * @brief append a row of cells to the sparse structure, with run-length 
+ * encoded full/empty cells and the list of the cut cells
+ * @param sp sparse structure
+ * @param ccr volume fraction values of the row
+ * @param nx number of cells of the row
+ * @param m0 index of the first cell of the row
+ * @return ist: success/failure (0/-1)
+ */
+int vofi_get_sparse_row(vofi_sparse *,vofi_creal [],vofi_cint,long int);
+
+
+/**
+ * @brief initialize the point cache of a cell
+ * @param pch point cache
+ * @param impl_func pointer to the implicit function
+ * @param icache use the cache (else only count the evaluations)
+ */
+void vofi_init_cache(pch_data *,integrand,void *,vofi_cint);
+
+
+/**
+ * @brief implicit function with the point cache, the cache is passed as
+ * the user data
+ * @param pch point cache
+ * @param xy point
+ * @return f: value of the implicit function
+ */
+vofi_real vofi_get_cache_f(void *,vofi_creal []);
+
+
+/**
+ * @brief initialize the edge cache of a sweep of the grid
+ * @param ped edge cache
+ * @param grid grid structure
+ */
+void vofi_init_edges(edg_data *,const vofi_grid *);
+
+
+/**
+ * @brief free the memory of the edge cache
+ * @param ped edge cache
+ */
+void vofi_free_edges(edg_data *);
+
+
+/**
+ * @brief start a new generation of the edge cache, the table becomes the
+ * previous generation and the older one is evicted, or with ped->keep the
+ * table grows (no thread must use the cache)
+ * @param ped edge cache
+ */
+void vofi_age_edges(edg_data *);
+
+
+/**
+ * @brief double the size of the table of the edge cache when it has not 
+ * room for more entries, keeping all of them (no thread must use the cache)
+ * @param ped edge cache
+ */
+void vofi_grow_edges(edg_data *);
+
+
+/**
+ * @brief get the index of the vertex x1 of the grid, and move x1 exactly on
+ * it
+ * @param ped edge cache
+ * @param x1 point
+ * @return iv: index of the vertex (-1: not a vertex of the grid)
+ */
+long int vofi_get_vertex_index(const edg_data *,vofi_real []);
+
+
+/**
+ * @brief get the index of the edge of the grid starting at x1 along a
+ * direction, and move x1 exactly on the vertex of the grid
+ * @param ped edge cache (may be NULL)
+ * @param x1 starting point
+ * @param stdir direction
+ * @return ie: index of the edge (-1: no cache or not an edge of the grid)
+ */
+long int vofi_get_edge_index(const edg_data *,vofi_real [],vofi_creal []);
+
+
+/**
+ * @brief get the index of the face of the grid with minor vertex x1, normal
+ * to the primary direction and searched along the tertiary direction, and 
+ * move x1 exactly on the vertex of the grid
+ * @param ped edge cache (may be NULL)
+ * @param x1 minor vertex
+ * @param pdir primary direction
+ * @param tdir tertiary direction
+ * @return ie: index of the face (-1: no cache or not a face of the grid)
+ */
+long int vofi_get_face_index(const edg_data *,vofi_real [],vofi_creal [],vofi_creal []);
+
+
+/**
+ * @brief position of an edge in the table of the edge cache
+ * @param ie index of the edge
+ * @param ne size of the table (a power of 2)
+ * @return j: position in the table
+ */
+long int vofi_hash_edge(long int,long int);
+
+
+/**
+ * @brief look up an edge (or a face) in the previous generation and then in
+ * the table of the edge cache, shared by the threads without locks, if not
+ * found take a free entry for it
+ * @param ped edge cache
+ * @param ie index of the edge
+ * @param sz position of the intersections
+ * @param j entry taken by the caller, that must compute the values and 
+ * call vofi_keep_edge (-1: none)
+ * @return nz: number of intersections (-1: not found)
+ */
+int vofi_find_edge(edg_data *,long int,vofi_real [],long int *);
+
+
+/**
+ * @brief put the values of an edge (or a face) in the entry taken by 
+ * vofi_find_edge and mark them as ready for the other threads
+ * @param ped edge cache
+ * @param j entry of the table (-1: none)
+ * @param nz number of intersections
+ * @param sz position of the intersections
+ */
+void vofi_keep_edge(edg_data *,long int,vofi_cint,vofi_creal []);
+
+
+/**
+ * @brief same as vofi_get_side_intersections, with the intersections of 
+ * the edge taken from the edge cache, if already computed by another cell
+ * @param impl_func pointer to the implicit function
+ * @param fe function value at the endpoints
+ * @param x1 starting point
+ * @param lim_intg array of the limits of integration
+ * @param stdir direction
+ * @param h0 grid spacing
+ * @param nsub number of subdivisions
+ * @param ped edge cache
+ * @param ie index of the edge (-1: no cache)
+ * @return ist: success/no room for the limits (0/-1)
+ */
+int vofi_get_edge_intersections(integrand,void *,vofi_real [],vofi_creal [],vofi_real [],vofi_creal [],
+                                 vofi_creal,vofi_int_cpt,edg_data *,long int);
+
+
+/**
+ * @brief get the extra limits in a face with the four vertices of the same
+ * sign, with the limits taken from the edge cache, if already computed by 
+ * the other cell of the face
+ * @param impl_func pointer to the implicit function
+ * @param fv function value at the vertices
+ * @param x1 minor vertex of the face
+ * @param lim_intg array of the limits of integration
+ * @param sdir secondary direction
+ * @param tdir tertiary direction
+ * @param h0 grid spacing
+ * @param nsub number of subdivisions
+ * @param ped edge cache
+ * @param ie index of the face (-1: no cache)
+ * @return ist: success/no room for the limits (0/-1)
+ */
+int vofi_get_face_limits(integrand,void *,vofi_creal [],vofi_creal [],vofi_real [],vofi_creal [],
+                          vofi_creal [],vofi_creal,vofi_int_cpt,edg_data *,long int);
+
+
+/**
+ * @brief real roots of a*x^2 + b*x + c = 0 with the stable formula
+ * @param a coefficient of x^2
+ * @param b coefficient of x
+ * @param c constant term
+ * @param r roots in increasing order
+ * @return nr: number of roots (0, 1, 2)
+ */
+int vofi_get_quadric_roots(vofi_creal,vofi_creal,vofi_creal,vofi_real []);
+
+
+/**
+ * @brief zeroes of a*x^2 + b*x + c = 0 that are singular points of the 
+ * heights of a quadric, the complex ones are kept in the list of the zeroes
+ * @param a coefficient of x^2
+ * @param b coefficient of x
+ * @param c constant term
+ * @param r real zeroes
+ * @param pqd list of the zeroes
+ * @return nr: number of real zeroes
+ */
+int vofi_get_quadric_zeroes(vofi_creal,vofi_creal,vofi_creal,vofi_real [],qdr_data *);
+
+
+/**
+ * @brief add a real zero to the list of the zeroes, and to the limits of
+ * integration if the singular point is inside the cell and inside (0,1)
+ * @param z real zero
+ * @param iin the singular point is inside the cell (1) or not (0)
+ * @param lim_intg array of the limits of integration
+ * @param nlim number of limits
+ * @param pqd list of the zeroes
+ * @return nlim: updated number of limits
+ */
+int vofi_add_quadric_singular(vofi_creal,vofi_cint,vofi_real [],int,qdr_data *);
+
+
+/**
+ * @brief add the roots of a*x^2 + b*x + c = 0 inside (0,1) to the limits of
+ * integration
+ * @param a coefficient of x^2
+ * @param b coefficient of x
+ * @param c constant term
+ * @param lim_intg array of the limits of integration
+ * @param nlim number of limits
+ * @return nlim: updated number of limits
+ */
+int vofi_add_quadric_limits(vofi_creal,vofi_creal,vofi_creal,vofi_real [],int);
+
+
+/**
+ * @brief add the coordinates t where the conic of a face along t is 
+ * tangent to the line t = const inside the face to the singular points
+ * @param cf coefficients of the conic {A,B,C,D,E,G}
+ * @param lim_intg array of the limits of integration
+ * @param nlim number of limits
+ * @param pqd list of the zeroes
+ * @return nlim: updated number of limits
+ */
+int vofi_add_quadric_tangents(vofi_creal [],vofi_real [],int,qdr_data *);
+
+
+/**
+ * @brief nodes and weights of the Gauss-Legendre quadrature in a smooth
+ * subdivision, with the number of points given by the nearest singular point
+ * @param l0 start of the subdivision
+ * @param l1 end of the subdivision
+ * @param pqd list of the zeroes
+ * @param xs nodes
+ * @param ws weights
+ * @return npt: number of points (0: halve the subdivision)
+ */
+int vofi_get_quadric_nodes(vofi_creal,vofi_creal,const qdr_data *,vofi_real [],vofi_real []);
+
+
+/**
+ * @brief length of the segment 0 <= p <= 1 where a*p^2 + b*p + c < 0
+ * @param a coefficient of p^2
+ * @param b coefficient of p
+ * @param c constant term
+ * @return ht: normalized length
+ */
+vofi_real vofi_get_quadric_length(vofi_creal,vofi_creal,vofi_creal);
+
+
+/**
+ * @brief normalized area of the unit square where a conic is negative,
+ * with the exact heights and a single quadrature in each smooth subdivision
+ * @param cf coefficients {a,e,f,u,v,w} of a p^2 + 2e p s + f s^2 + u p + v s + w
+ * @param nl number of empty, full and cut lines
+ * @return area: normalized area
+ */
+vofi_real vofi_get_quadric_area(vofi_creal [],int []);
+
+
+/**
+ * @brief compute the volume fraction of a cell with a quadric interface,
+ * without any root search
+ * @param q coefficients of the quadric
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param ndim0 space dimension
+ * @param icc full/empty/cut cell (1/0/-1)
+ * @return cc: volume fraction value (-1: degenerate quadric)
+ */
+vofi_real vofi_get_cc_quadric(const vofi_quadric *,vofi_creal [],vofi_creal,vofi_cint,vofi_int_cpt);
+
+
+/**
+ * @brief check if the implicit function is linear in a cell, with the f
+ * values on the local grid of vofi_get_dirs and two more values
+ * @param impl_func pointer to the implicit function
+ * @param x0 starting point
+ * @param f0 f values on the 3x3(x3) local grid
+ * @param h0 grid spacing
+ * @param ndim0 space dimension
+ * @param tol tolerance of the linear fit
+ * @param pln least-squares linear fit in the normalized cell
+ * @return ipl: linear function (1/0)
+ */
+int vofi_get_plane(integrand,void *,vofi_creal [],vofi_real [][NLSX][NLSY],vofi_creal,vofi_cint,
+                   vofi_creal,vofi_real []);
+
+
+/**
+ * @brief compute the volume fraction of a cell cut by a plane with the 
+ * analytic relations
+ * @param pln linear function in the normalized cell
+ * @param ndim0 space dimension
+ * @return cc: volume fraction value
+ */
+vofi_real vofi_get_plane_cc(vofi_creal [],vofi_cint);
+
+
+/**
+ * @brief set the Gauss-Legendre nodes and weights of the quadrature rules 
+ * of a cell
+ * @param prl quadrature rules of the cell
+ * @param rule arrays of the caller (may be NULL)
+ * @param npr number of nodes (4, 8, 12, 16 or 20, else 20)
+ * @param ndim0 space dimension
+ * @return npr: number of nodes
+ */
+int vofi_init_rule(rul_data *,vofi_rule *,vofi_cint,vofi_cint);
+
+
+/**
+ * @brief add the nodes of a segment along the primary direction to the 
+ * volume rule of a cell, or to the integral of the weight function
+ * @param prl quadrature rules of the cell
+ * @param xb base point of the column
+ * @param pdir primary direction
+ * @param p0 start of the segment along the column
+ * @param hp length of the segment
+ * @param ws weight of the column in the internal integration
+ */
+void vofi_add_rule_column(rul_data *,vofi_creal [],vofi_creal [],vofi_creal,vofi_creal,vofi_creal);
+
+
+/**
+ * @brief add the nodes of a full rectangle to the volume rule of a cell
+ * @param prl quadrature rules of the cell
+ * @param xb base point of the rectangle
+ * @param pdir primary direction
+ * @param sdir secondary direction
+ * @param s0 lower limit along the secondary direction
+ * @param s1 upper limit along the secondary direction
+ * @param h0 side along the primary direction
+ */
+void vofi_add_rule_rect(rul_data *,vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal,vofi_creal,
+                        vofi_creal);
+
+
+/**
+ * @brief add the nodes of a full (sub)cell to the volume rule of a cell
+ * @param prl quadrature rules of the cell
+ * @param x0 starting point
+ * @param h0 grid spacing
+ * @param ndim0 space dimension
+ */
+void vofi_add_rule_box(rul_data *,vofi_creal [],vofi_creal,vofi_cint);
+
+
+/**
+ * @brief add an interface point to the interface rule of a cell, with its
+ * normal and the surface element
+ * @param impl_func pointer to the implicit function
+ * @param prl quadrature rules of the cell
+ * @param xs interface point
+ * @param pdir primary direction
+ * @param h0 grid spacing
+ * @param ws weight of the column in the internal integration
+ */
+void vofi_add_rule_point(integrand,void *,rul_data *,vofi_creal [],vofi_creal [],vofi_creal,
+                         vofi_creal);
+
+
+/**
+ * @brief implicit function restricted to the plane of a face
+ * @param pfc face data (as user data)
+ * @param xy point in the plane of the face
+ * @return f: value of the implicit function in the 3D point
+ */
+vofi_real vofi_get_face_f(void *,vofi_creal []);
+
+
+/**
+ * @brief wetted fraction of a cell side, where the implicit function is 
+ * negative
+ * @param impl_func pointer to the implicit function
+ * @param x1 starting point
+ * @param stdir direction of the side
+ * @param h0 grid spacing
+ * @param ped edge cache of the grid sweep (may be NULL)
+ * @return ae: wetted fraction of the side
+ */
+vofi_real vofi_get_edge_fraction(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal,edg_data *);
+
+
+/**
+ * @brief aperture of a cell face in 3D, the 2D volume fraction of the face
+ * @param impl_func pointer to the implicit function
+ * @param x1 minor vertex of the face
+ * @param jn normal direction
+ * @param h0 grid spacing
+ * @param fh characteristic function value
+ * @return af: aperture of the face
+ */
+vofi_real vofi_get_face_fraction(integrand,void *,vofi_creal [],vofi_cint,vofi_creal,vofi_creal);
+
+
+/**
+ * @brief value of a full or empty cell that contains a face or an edge
+ * @param grid grid structure
+ * @param cc volume fraction values
+ * @param iv indices of the minor vertex of the face (edge)
+ * @param mask directions across the face (edge), one bit each
+ * @return ca: 1/0 with a full/empty cell, -1 if all cells are cut
+ */
+vofi_real vofi_get_adjacent_cc(const vofi_grid *,vofi_creal [],vofi_cint [],vofi_cint);
+
+
+/**
+ * @brief apertures of all faces normal to a direction, or of all edges 
+ * along a direction, of a grid
+ * @param impl_func pointer to the implicit function
+ * @param grid grid structure
+ * @param fh characteristic function value
+ * @param cc volume fraction values
+ * @param jd direction
+ * @param iface faces (1) or edges (0)
+ * @param ped edge cache of the grid sweep (may be NULL)
+ * @param ap apertures
+ */
+void vofi_get_apertures_dir(integrand,void *,const vofi_grid *,vofi_creal,vofi_creal [],vofi_cint,
+                            vofi_cint,edg_data *,vofi_real []);
+
+
+/**
+ * @brief unit normal and offset of the plane of a cut cell, with the volume
+ * fraction of the cell
+ * @param g gradient of the f values at the vertices of the cell
+ * @param xp intersections of the interface with the cell sides, ordered
+ * around g
+ * @param npt number of intersections
+ * @param ndim0 space dimension
+ * @param cc volume fraction value
+ * @param pln plane, normal in pln[0..2] and offset in pln[3]
+ */
+void vofi_get_plic_plane(vofi_creal [],vofi_real [][NDIM],vofi_cint,vofi_cint,vofi_creal,
+                         vofi_real []);
+
+
+/**
+ * @brief intersections of the interface with the sides of a cut cell, from
+ * the edge cache of the grid sweep, and plane of the cell
+ * @param impl_func pointer to the implicit function
+ * @param ped edge cache of the grid sweep
+ * @param x0 minor vertex of the cell
+ * @param h0 grid spacing
+ * @param ndim0 space dimension
+ * @param cc volume fraction value
+ * @param pln plane of the cell
+ * @param xp intersections, ordered around the normal of the plane
+ * @return npt: number of intersections
+ */
+int vofi_get_plic_cell(integrand,void *,edg_data *,vofi_creal [],vofi_creal,vofi_cint,vofi_creal,
+                       vofi_real [],vofi_real [][NDIM]);
+
+
+/**
+ * @brief make room for one more cut cell and n more points in the PLIC 
+ * structure
+ * @param pl PLIC structure
+ * @param n number of new points
+ * @return ist: success/failure (0/-1)
+ */
+int vofi_get_plic_room(vofi_plic *,vofi_cint);
+
+
+/**
+ * @brief unit normal of the interface with centred differences
+ * @param impl_func pointer to the implicit function
+ * @param xs point
+ * @param h0 grid spacing
+ * @param ndim0 space dimension
+ * @param nv unit normal
+ * @return ist: success/failure (1/0)
+ */
+int vofi_get_sdf_normal(integrand,void *,vofi_creal [],vofi_creal,vofi_cint,vofi_real []);
+
+
+/**
+ * @brief zero of the implicit function on a line, from a point towards an
+ * interface point
+ * @param impl_func pointer to the implicit function
+ * @param xc point of the line
+ * @param dir unit direction of the line
+ * @param xs interface point
+ * @param h0 grid spacing
+ * @param x1 zero on the line
+ * @return ist: success/failure (1/0)
+ */
+int vofi_get_sdf_line(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal [],vofi_creal,
+                      vofi_real []);
+
+
+/**
+ * @brief distance of a point from the interface, starting from a point of
+ * the interface, with zeroes along the lines through the point and the
+ * estimated centre of curvature
+ * @param impl_func pointer to the implicit function
+ * @param xc point
+ * @param xs interface point
+ * @param h0 grid spacing
+ * @param ndim0 space dimension
+ * @return ds: distance of xc from the interface
+ */
+vofi_real vofi_get_sdf_cell(integrand,void *,vofi_creal [],vofi_creal [],vofi_creal,vofi_cint);
+
+
+/**
+ * @brief implicit function of space and time at the time of the data, the
+ * data are passed as the user data
+ * @param ptm function of space and time, its data and the time
+ * @param xy point
+ * @return f: value of the implicit function
+ */
+vofi_real vofi_get_time_f(void *,vofi_creal []);
+
+
+/**
+ * @brief initialize the map of the reference square (cube) onto an element, or
+ * onto one of its subcells, given its vertices in the order of VTK
+ * @param pmp map of the element
+ * @param impl_func pointer to the implicit function
+ * @param xv vertices of the element (three coordinates each)
+ * @param nv number of vertices: 3, 4 in 2D and 4, 5, 6, 8 in 3D
+ * @param ndim0 space dimension
+ * @param isub subcell (-1: whole element, collapsed at some corners)
+ * @return nsub: number of subcells (-1: not a supported element)
+ */
+int vofi_init_map(map_data *,integrand,void *,vofi_creal [],vofi_cint,vofi_cint,vofi_cint);
+
+
+/**
+ * @brief point of the element and Jacobian matrix of the map at a point of 
+ * the reference square (cube)
+ * @param pmp map of the element
+ * @param xi point of the reference cell
+ * @param x point of the element
+ * @param jac Jacobian matrix, jac[n][m] = dx[n]/dxi[m]
+ */
+void vofi_get_map_x(const map_data *,vofi_creal [],vofi_real [],vofi_real [][NDIM]);
+
+
+/**
+ * @brief side of the reference square (cube) of a map, of the size of the
+ * element
+ * @param pmp map of the element
+ */
+void vofi_get_map_size(map_data *);
+
+
+/**
+ * @brief implicit function at the point of the element mapped from a point
+ * of the reference square (cube), the map is passed as the user data
+ * @param pmp map of the element
+ * @param xi point of the reference cell
+ * @return f: value of the implicit function
+ */
+vofi_real vofi_get_map_f(void *,vofi_creal []);
+
+
+/**
+ * @brief absolute value of the Jacobian determinant of the map, the map is
+ * passed as the weight data
+ * @param pmp map of the element
+ * @param xi point of the reference cell
+ * @return dj: |det(dx/dxi)|
+ */
+vofi_real vofi_get_map_jac(void *,vofi_creal []);
+
+
+/**
+ * @brief volume fraction of the simplex of an affine map, classified once 
+ * with vofi_get_dirs and integrated in the corner sum(xi) <= hs of its 
+ * reference cell
+ * @param pmp map of the simplex
+ * @param fh characteristic function value of the reference cell
+ * @param ndim0 space dimension
+ * @param icc full/empty/cut simplex (1/0/-1)
+ * @return cc: volume fraction of the simplex (-1: no room for the limits)
+ */
+vofi_real vofi_get_cc_simplex(map_data *,vofi_creal,vofi_cint,vofi_int_cpt);
+
+
+#endif
@@ -0,0 +1,263 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getaperture.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the driver that computes the volume fraction of all
+ *        cells of a grid together with the apertures of the faces and of
+ *        the edges, for embedded-boundary solvers.
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function restricted to the plane of a face: the two coordinates   *
+ * of a point in the plane are mapped to the in-plane directions of the face  *
+ * INPUT: face data pfc (as user data), point xy in the plane                 *
+ * OUTPUT: f: value of the implicit function in the corresponding 3D point   *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_face_f(void *pfc0,vofi_creal xy[])
+{
+  vofi_real x3[NDIM];
+  fac_data *pfc = (fac_data *) pfc0;
+
+  x3[pfc->ja] = xy[0];
+  x3[pfc->jb] = xy[1];
+  x3[pfc->jn] = pfc->xn;
+
+  return pfc->impl_func(pfc->userdata,x3);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * wetted fraction of a cell side, where f < 0: the intersections with the    *
+ * interface are those of the cell sides in the integration, taken from the   *
+ * edge cache of the grid sweep if already computed, a side with the end      *
+ * points of the same sign may have two intersections                         *
+ * INPUT: pointer to the implicit function, starting point x1, direction      *
+ * stdir, grid spacing h0, edge cache ped (may be NULL)                       *
+ * OUTPUT: ae: wetted fraction of the side                                    *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_edge_fraction(integrand impl_func,void *userdata,vofi_creal x1[],
+                                 vofi_creal stdir[],vofi_creal h0,edg_data *ped)
+{
+  int i,nsub,ineg;
+  long int ie;
+  vofi_real xs[NDIM],x2[NDIM],fe[NEND],lim[NSEG];
+  vofi_real ae;
+
+  for (i=0;i<NDIM;i++)
+    xs[i] = x1[i];
+  ie = vofi_get_edge_index(ped,xs,stdir);       /* xs on the grid vertex */
+  for (i=0;i<NDIM;i++)
+    x2[i] = xs[i] + stdir[i]*h0;
+  fe[0] = impl_func(userdata,xs);
+  fe[1] = impl_func(userdata,x2);
+  ineg = (fe[0] < 0.);
+
+  nsub = 0;
+  vofi_get_edge_intersections(impl_func,userdata,fe,xs,lim,stdir,h0,&nsub,ped,ie);
+  if (nsub == 0)                                     /* full or empty side */
+    ae = (vofi_real) ineg;
+  else if (nsub == 1)                         /* single intersection lim[0] */
+    ae = ineg ? lim[0]/h0 : 1. - lim[0]/h0;
+  else                            /* two intersections, ends of same sign */
+    ae = ineg ? 1. - (lim[1] - lim[0])/h0 : (lim[1] - lim[0])/h0;
+
+  return ae;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * aperture of a cell face in 3D, the 2D volume fraction of the face with     *
+ * the implicit function restricted to its plane                              *
+ * INPUT: pointer to the implicit function, minor vertex x1 of the face,      *
+ * normal direction jn, grid spacing h0, characteristic function value fh    *
+ * OUTPUT: af: aperture of the face                                           *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_face_fraction(integrand impl_func,void *userdata,vofi_creal x1[],vofi_cint jn,
+                                 vofi_creal h0,vofi_creal fh)
+{
+  int icc;
+  vofi_real xf[NDIM];
+  fac_data fac;
+
+  fac.impl_func = impl_func;
+  fac.userdata = userdata;
+  fac.jn = jn;
+  fac.ja = (jn == 0) ? 1 : 0;
+  fac.jb = (jn == 2) ? 1 : 2;
+  fac.xn = x1[jn];
+  xf[0] = x1[fac.ja];
+  xf[1] = x1[fac.jb];
+  xf[2] = 0.;
+
+  return vofi_get_cc_cell(vofi_get_face_f,&fac,xf,h0,fh,2,NULL,NULL,&icc);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * value of a full or empty cell of the grid that contains a face or an edge, *
+ * the face or the edge is then also full or empty                            *
+ * INPUT: grid structure, volume fraction values cc, indices iv of the minor  *
+ * vertex of the face (edge), directions jt across the face (edge) in the     *
+ * bits of mask: the cells are iv - sum of the unit vectors of any subset     *
+ * OUTPUT: ca: 1/0 with a full/empty cell, -1 if all cells are cut           *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_adjacent_cc(const vofi_grid *grid,vofi_creal cc[],vofi_cint iv[],vofi_cint mask)
+{
+  int n,s,inside,ic[NDIM];
+  long int m;
+
+  for (s=0;s<(1<<NDIM);s++) {
+    if ((s & mask) != s)
+      continue;
+    inside = 1;
+    for (n=0;n<NDIM;n++) {
+      ic[n] = iv[n] - ((s >> n) & 1);
+      if (ic[n] < 0 || ic[n] >= ((n < grid->ndim) ? grid->nc[n] : 1))
+	inside = 0;
+    }
+    if (!inside)
+      continue;
+    m = ic[0] + grid->nc[0]*(ic[1] + (long int) grid->nc[1]*ic[2]);
+    if (cc[m] == 0. || cc[m] == 1.)
+      return cc[m];
+  }
+
+  return -1.;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * apertures of all faces (iface = 1) normal to direction jd, or of all edges *
+ * (iface = 0) along jd, of a grid: each face (edge) is computed once and is  *
+ * shared by its cells, a face (edge) of a full or empty cell takes its       *
+ * value, the others are computed with vofi_get_face_fraction in 3D and with  *
+ * vofi_get_edge_fraction for the edges and for the faces in 2D, with the     *
+ * edge cache of the grid sweep, and with nthr OpenMP threads if available    *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh, volume fraction values cc, direction jd, switch iface,  *
+ * edge cache ped (may be NULL)                                               *
+ * OUTPUT: ap: apertures, ap[i + nv[0]*(j + nv[1]*k)], nv[n] = nc[n] + 1 along *
+ * jd for the faces and along the other directions for the edges             *
+ * -------------------------------------------------------------------------- */
+
+void vofi_get_apertures_dir(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                            vofi_creal cc[],vofi_cint jd,vofi_cint iface,edg_data *ped,
+                            vofi_real ap[])
+{
+  int n,mask,js,iv[NDIM],nv[NDIM];
+  long int m,nt;
+  vofi_real x1[NDIM],stdir[NDIM];
+  vofi_real ca;
+#ifdef _OPENMP
+  int nthr;
+#endif
+
+  nt = 1;
+  mask = 0;
+  for (n=0;n<NDIM;n++) {
+    nv[n] = 1;
+    if (n < grid->ndim) {
+      nv[n] = grid->nc[n];
+      if ((iface && n == jd) || (!iface && n != jd)) {
+	nv[n]++;
+	mask |= 1 << n;
+      }
+    }
+    nt *= nv[n];
+  }
+  js = (grid->ndim == 2) ? 1 - jd : jd;     /* side of a face in 2D, or edge */
+
+#ifdef _OPENMP
+  nthr = (grid->nthr > 0) ? grid->nthr : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic,64) num_threads(nthr) private(n,iv,x1,stdir,ca)
+#endif
+  for (m=0;m<nt;m++) {                             /* loop over faces (edges) */
+    iv[0] = (int) (m % nv[0]);
+    iv[1] = (int) ((m / nv[0]) % nv[1]);
+    iv[2] = (int) (m / ((long int) nv[0]*nv[1]));
+    ca = vofi_get_adjacent_cc(grid,cc,iv,mask);
+    if (ca < 0.) {
+      for (n=0;n<NDIM;n++) {
+	x1[n] = grid->x0[n] + iv[n]*grid->h0;
+	stdir[n] = 0.;
+      }
+      stdir[js] = 1.;
+      if (iface && grid->ndim == 3)
+	ca = vofi_get_face_fraction(impl_func,userdata,x1,jd,grid->h0,fh);
+      else
+	ca = vofi_get_edge_fraction(impl_func,userdata,x1,stdir,grid->h0,ped);
+    }
+    ap[m] = ca;
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction of all cells of a grid, with the     *
+ * whole-grid driver, and the apertures of all faces and, in 3D, of all edges *
+ * (the wetted fraction where f < 0), for cut-cell and embedded-boundary      *
+ * solvers, in one pass: the edge cache of the grid sweep is kept, as in      *
+ * vofi_Get_plic, hence the intersections of the sides already used by the    *
+ * integration are not searched again                                         *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh                                                          *
+ * OUTPUT: cc: volume fraction values, af[jd]: apertures of the faces normal  *
+ * to jd, ae[jd]: fractions of the edges along jd (3D only, may be NULL),     *
+ * vol: total volume of the reference phase                                   *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_apertures(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                             vofi_real cc[],vofi_real *af[],vofi_real *ae[])
+{
+  int jd;
+  vofi_real vol;
+  edg_data edg;
+
+  vofi_init_edges(&edg,grid);
+  edg.keep = 1;                              /* all the edges for the sides */
+  vol = vofi_get_cc_edges(impl_func,userdata,grid,fh,0,grid->nc[grid->ndim-1],NULL,cc,&edg);
+
+  for (jd=0;jd<grid->ndim;jd++) {
+    vofi_grow_edges(&edg);                  /* no thread uses the cache here */
+    vofi_get_apertures_dir(impl_func,userdata,grid,fh,cc,jd,1,&edg,af[jd]);
+  }
+  if (grid->ndim == 3 && ae != NULL)
+    for (jd=0;jd<grid->ndim;jd++) {
+      vofi_grow_edges(&edg);
+      vofi_get_apertures_dir(impl_func,userdata,grid,fh,cc,jd,0,&edg,ae[jd]);
+    }
+  vofi_free_edges(&edg);
+
+  return vol;
+}
@@ -0,0 +1,559 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getcache.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief Small cache of the implicit function values inside a single
+ *        cell, with the counters of the function evaluations, and cache
+ *        of the edge intersections shared by the cells of a grid sweep.
+ */
+
+#include <string.h>
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * initialize the point cache of a cell: the cache is passed to the internal  *
+ * routines as the user data of the implicit function vofi_get_cache_f, so    *
+ * the points evaluated more than once in the cell (vertices, side endpoints, *
+ * face points) are computed only once                                        *
+ * INPUT: pointer to the implicit function and its user data, icache: use    *
+ * the cache (else only count the evaluations)                                *
+ * OUTPUT: pch: initialized cache                                             *
+ * -------------------------------------------------------------------------- */
+
+void vofi_init_cache(pch_data *pch,integrand impl_func,void *userdata,vofi_cint icache)
+{
+  int i;
+
+  pch->impl_func = impl_func;
+  pch->userdata = userdata;
+  pch->icache = icache;
+  pch->nfunc = pch->nsave = 0;
+  if (icache)
+    for (i=0;i<NPCH;i++)
+      pch->ic[i] = 0;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function with the point cache: the point is looked up with the   *
+ * exact coordinates in a direct-mapped table, on a miss the user function   *
+ * is called and its value replaces the entry                                 *
+ * INPUT: cache pch (as user data), point xy                                  *
+ * OUTPUT: f: value of the implicit function in xy                            *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_cache_f(void *pch0,vofi_creal xy[])
+{
+  int i;
+  unsigned long long b[NDIM],hk;
+  vofi_real f;
+  pch_data *pch = (pch_data *) pch0;
+
+  if (!pch->icache) {
+    pch->nfunc++;
+    return pch->impl_func(pch->userdata,xy);
+  }
+
+  memcpy(b,xy,sizeof(b));
+  hk = b[0]*0x9E3779B97F4A7C15ULL ^ b[1]*0xC2B2AE3D27D4EB4FULL ^ b[2]*0x165667B19E3779F9ULL;
+  hk ^= hk >> 33;                    /* mix the high bits into the low bits */
+  hk *= 0xFF51AFD7ED558CCDULL;
+  hk ^= hk >> 33;
+  i = (int) (hk & (NPCH-1));
+  if (pch->ic[i] && memcmp(pch->xc[i],xy,sizeof(b)) == 0) {
+    pch->nsave++;
+    return pch->fc[i];
+  }
+
+  f = pch->impl_func(pch->userdata,xy);
+  pch->nfunc++;
+  memcpy(pch->xc[i],xy,sizeof(b));
+  pch->fc[i] = f;
+  pch->ic[i] = 1;
+
+  return f;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * initialize the edge cache of a sweep of the grid: an edge belongs to 2     *
+ * (4) cells in 2D (3D), its intersections with the interface are computed   *
+ * by the first cell and then looked up by the others, also when the cells   *
+ * are in different threads; the first table is sized from the edges of a     *
+ * row of blocks along x, as an interface crosses a layer of blocks along a   *
+ * line, it then grows with vofi_age_edges or vofi_grow_edges up to the       *
+ * number of edges in a plane (line) of the grid in 3D (2D); when the         *
+ * table is 3/4 full, or if memory is not available, the new edges are        *
+ * computed without the cache and counted in nmiss                            *
+ * INPUT: grid structure                                                      *
+ * OUTPUT: ped: initialized edge cache                                        *
+ * -------------------------------------------------------------------------- */
+
+void vofi_init_edges(edg_data *ped,const vofi_grid *grid)
+{
+  int n;
+  long int ne,nf,nb[NDIM];
+
+  for (n=0;n<NDIM;n++) {
+    ped->x0[n] = grid->x0[n];
+    ped->nv[n] = (n < grid->ndim) ? grid->nc[n] + 1 : 1;
+    nb[n] = (n == 0) ? ped->nv[0] : MIN(ped->nv[n],MAX(grid->nblk,1) + 1);
+  }
+  ped->h0 = grid->h0;
+  if (grid->ndim == 2)
+    nf = ped->nv[0] + ped->nv[1];
+  else
+    nf = ped->nv[0]*ped->nv[1] + ped->nv[1]*ped->nv[2] + ped->nv[0]*ped->nv[2];
+  for (ne=NEDG;ne<2*NDIM*nf;ne*=2);
+  ped->nmax = ne;
+  if (grid->ndim == 2)                     /* edges of a row of blocks */
+    nf = nb[0] + nb[1];
+  else
+    nf = nb[0]*nb[1] + nb[1]*nb[2] + nb[0]*nb[2];
+  for (ne=NEDG;ne<2*NDIM*nf && ne<ped->nmax;ne*=2);
+  ped->nused = ped->nmiss = ped->nstep = ped->nlast = 0;
+  ped->keep = 0;
+  ped->tab = (edg_entry *) calloc(ne,sizeof(edg_entry));
+  ped->ne = (ped->tab != NULL) ? ne : 0;
+  ped->neo = 0;
+  ped->old = NULL;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * free the memory of the edge cache                                          *
+ * INPUT: edge cache ped                                                      *
+ * OUTPUT: none                                                               *
+ * -------------------------------------------------------------------------- */
+
+void vofi_free_edges(edg_data *ped)
+{
+  free(ped->tab);
+  free(ped->old);
+  ped->tab = ped->old = NULL;
+  ped->ne = ped->neo = ped->nused = 0;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * start a new generation of the edge cache, when no thread uses it (e.g.     *
+ * between two layers of blocks of a grid sweep): the table becomes the       *
+ * previous generation, still looked up but read only, and the older one is   *
+ * evicted and reused as the new table; the new table is at least four times  *
+ * the largest number of entries taken in a generation, and at least twice    *
+ * the last one if some edges did not find room in it, up to nmax; with a     *
+ * sweep by layers an edge is not evicted before its last cell, since its     *
+ * cells are in the same layer or in two consecutive ones; if ped->keep the   *
+ * edges are never evicted, the table grows with vofi_grow_edges              *
+ * INPUT: edge cache ped                                                      *
+ * OUTPUT: ped: updated edge cache                                            *
+ * -------------------------------------------------------------------------- */
+
+void vofi_age_edges(edg_data *ped)
+{
+  long int ne;
+  edg_entry *pt;
+
+  if (ped->ne == 0)                          /* no memory for the table */
+    return;
+  ped->nstep = MAX(ped->nstep,ped->nused - ped->nlast);
+  if (ped->keep) {
+    ped->nlast = ped->nused;
+    vofi_grow_edges(ped);
+    return;
+  }
+  ne = ped->ne;
+  if (ped->nmiss > 0)
+    ne *= 2;
+  while (ne < 4*ped->nstep)
+    ne *= 2;
+  ne = MIN(ne,ped->nmax);
+
+  pt = ped->old;                                /* evict the older table */
+  if (pt != NULL && ped->neo == ne)
+    memset(pt,0,ne*sizeof(edg_entry));
+  else {
+    free(pt);
+    pt = (edg_entry *) calloc(ne,sizeof(edg_entry));
+  }
+  ped->old = ped->tab;
+  ped->neo = ped->ne;
+  ped->tab = pt;
+  ped->ne = (pt != NULL) ? ne : 0;
+  ped->nused = ped->nmiss = ped->nlast = 0;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * double the size of the table of the edge cache, up to nmax, when it has    *
+ * not room for nstep more entries, or when some edges did not find room in   *
+ * it, and move all its entries in the new table, when no thread uses it      *
+ * (e.g. between two cells of the front driver, that visits the cells in no   *
+ * fixed order and keeps all the edges); if memory is not available the       *
+ * table is kept as it is                                                     *
+ * INPUT: edge cache ped                                                      *
+ * OUTPUT: ped: updated edge cache                                            *
+ * -------------------------------------------------------------------------- */
+
+void vofi_grow_edges(edg_data *ped)
+{
+  long int i,j,ne;
+  edg_entry *pt;
+
+  if (ped->ne == 0 || ped->ne >= ped->nmax)
+    return;
+  ne = ped->ne;
+  if (ped->nmiss > 0)
+    ne *= 2;
+  while (ne < 2*(ped->nused + ped->nstep))
+    ne *= 2;
+  ne = MIN(ne,ped->nmax);
+  if (ne == ped->ne)
+    return;
+
+  pt = (edg_entry *) calloc(ne,sizeof(edg_entry));
+  if (pt == NULL)
+    return;
+  for (i=0;i<ped->ne;i++)
+    if (ped->tab[i].key != 0) {
+      j = vofi_hash_edge(ped->tab[i].key-1,ne);
+      while (pt[j].key != 0)
+	j = (j+1) & (ne-1);
+      pt[j] = ped->tab[i];
+    }
+  free(ped->tab);
+  ped->tab = pt;
+  ped->ne = ne;
+  ped->nmiss = 0;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * get the index of the vertex x1 of the grid, and move x1 exactly on it, so  *
+ * that an edge or a face has the same endpoints, hence the same results, in  *
+ * all its cells                                                              *
+ * INPUT: edge cache ped, point x1                                            *
+ * OUTPUT: iv: index of the vertex (-1: not a vertex of the grid), x1: vertex *
+ * of the grid                                                                *
+ * -------------------------------------------------------------------------- */
+
+long int vofi_get_vertex_index(const edg_data *ped,vofi_real x1[])
+{
+  int n;
+  long int iv[NDIM];
+
+  for (n=0;n<NDIM;n++) {
+    iv[n] = (long int) floor((x1[n] - ped->x0[n])/ped->h0 + 0.5);
+    if (iv[n] < 0 || iv[n] >= ped->nv[n])
+      return -1;
+  }
+  for (n=0;n<NDIM;n++)
+    if (ped->nv[n] > 1)
+      x1[n] = ped->x0[n] + iv[n]*ped->h0;
+
+  return (iv[2]*ped->nv[1] + iv[1])*ped->nv[0] + iv[0];
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * get the index of the edge of the grid starting at x1 along the direction  *
+ * stdir, and move x1 exactly on the vertex of the grid (even indices are    *
+ * edges, odd indices are faces)                                             *
+ * INPUT: edge cache ped (may be NULL), starting point x1, direction stdir    *
+ * OUTPUT: ie: index of the edge (-1: no cache or not an edge of the grid),  *
+ * x1: vertex of the grid                                                     *
+ * -------------------------------------------------------------------------- */
+
+long int vofi_get_edge_index(const edg_data *ped,vofi_real x1[],vofi_creal stdir[])
+{
+  int n,m;
+  long int iv;
+
+  if (ped == NULL || ped->ne == 0)
+    return -1;
+  iv = vofi_get_vertex_index(ped,x1);
+  if (iv < 0)
+    return -1;
+  m = 0;
+  for (n=0;n<NDIM;n++)
+    if (stdir[n] > 0.5)
+      m = n;
+
+  return 2*(iv*NDIM + m);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * get the index of the face of the grid with minor vertex x1, normal to the  *
+ * direction pdir, searched along the tertiary direction tdir (the limits of  *
+ * the face are along tdir, hence they depend on it), and move x1 exactly on  *
+ * the vertex of the grid                                                     *
+ * INPUT: edge cache ped (may be NULL), minor vertex x1, primary and tertiary *
+ * directions pdir and tdir                                                   *
+ * OUTPUT: ie: index of the face (-1: no cache or not a face of the grid),   *
+ * x1: vertex of the grid                                                     *
+ * -------------------------------------------------------------------------- */
+
+long int vofi_get_face_index(const edg_data *ped,vofi_real x1[],vofi_creal pdir[],vofi_creal tdir[])
+{
+  int n,mp,mt;
+  long int iv;
+
+  if (ped == NULL || ped->ne == 0)
+    return -1;
+  iv = vofi_get_vertex_index(ped,x1);
+  if (iv < 0)
+    return -1;
+  mp = mt = 0;
+  for (n=0;n<NDIM;n++) {
+    if (pdir[n] > 0.5)
+      mp = n;
+    if (tdir[n] > 0.5)
+      mt = n;
+  }
+
+  return 2*((iv*NDIM + mp)*NDIM + mt) + 1;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * position of the edge ie in a table of size ne (a power of 2)               *
+ * INPUT: index of the edge ie, size of the table ne                          *
+ * OUTPUT: j: position in the table                                           *
+ * -------------------------------------------------------------------------- */
+
+long int vofi_hash_edge(long int ie,long int ne)
+{
+  unsigned long long hk;
+
+  hk = (unsigned long long) ie*0x9E3779B97F4A7C15ULL;
+  hk ^= hk >> 33;
+  hk *= 0xFF51AFD7ED558CCDULL;
+  hk ^= hk >> 33;
+
+  return (long int) (hk & (unsigned long long) (ne-1));
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * look up the edge (or face) ie in the previous generation, read only, and   *
+ * then in the table, with open addressing and linear probing, without        *
+ * locks and without waits: a free entry is taken by the first thread that    *
+ * increments its counter, that writes the key, computes the values and       *
+ * marks them as ready; a thread that finds the entry of its edge not ready   *
+ * yet, or a free entry just taken by another thread, computes the values by  *
+ * itself and does not keep them, hence no thread ever waits for another one  *
+ * and an edge is computed more than once only when two threads ask for it    *
+ * at the same time; the values are computed from the vertices of the grid,   *
+ * hence they do not depend on the thread that computed them                  *
+ * INPUT: edge cache ped, index of the edge ie                                *
+ * OUTPUT: nz: number of intersections (-1: not found), sz: their position,  *
+ * j: entry taken by the caller, that must compute the values and call       *
+ * vofi_keep_edge (-1: none, when found, when the table is full or when the   *
+ * entry is busy)                                                             *
+ * -------------------------------------------------------------------------- */
+
+int vofi_find_edge(edg_data *ped,long int ie,vofi_real sz[],long int *pj)
+{
+  int n,c,r;
+  long int i,j,k,nu;
+  edg_entry *pe;
+
+  *pj = -1;
+  if (ped->neo > 0) {            /* previous generation: complete, read only */
+    j = vofi_hash_edge(ie,ped->neo);
+    for (i=0;i<ped->neo && ped->old[j].key != 0;i++) {
+      pe = &ped->old[j];
+      if (pe->key == ie+1) {
+	for (n=0;n<pe->nz;n++)
+	  sz[n] = pe->sz[n];
+	return pe->nz;
+      }
+      j = (j+1) & (ped->neo-1);
+    }
+  }
+
+  j = vofi_hash_edge(ie,ped->ne);
+  for (i=0;i<ped->ne;i++) {
+    pe = &ped->tab[j];
+#pragma omp atomic read seq_cst
+    k = pe->key;
+    if (k == 0) {                                             /* free entry */
+#pragma omp atomic read seq_cst
+      nu = ped->nused;
+      if (4*nu >= 3*ped->ne) {                       /* the table is full */
+#pragma omp atomic update seq_cst
+	ped->nmiss += 1;
+	return -1;
+      }
+#pragma omp atomic capture seq_cst
+      { c = pe->cnt; pe->cnt += 1; }
+      if (c == 0) {                                     /* take the entry */
+#pragma omp atomic update seq_cst
+	ped->nused += 1;
+#pragma omp atomic write seq_cst
+	pe->key = ie+1;
+	*pj = j;
+	return -1;
+      }
+      return -1;             /* just taken by another thread, maybe this edge */
+    }
+    if (k == ie+1) {
+#pragma omp atomic read seq_cst
+      r = pe->rdy;
+      if (r == 0)                 /* same edge, still computed by its owner */
+	return -1;
+      for (n=0;n<pe->nz;n++)
+	sz[n] = pe->sz[n];
+      return pe->nz;
+    }
+    j = (j+1) & (ped->ne-1);
+  }
+
+  return -1;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * put the values of the edge (or face) in the entry j of the table, taken  *
+ * by vofi_find_edge, and mark them as ready for the other threads            *
+ * INPUT: edge cache ped, entry j (-1: none), number of intersections nz and *
+ * their position sz                                                          *
+ * OUTPUT: ped: updated edge cache                                            *
+ * -------------------------------------------------------------------------- */
+
+void vofi_keep_edge(edg_data *ped,long int j,vofi_cint nz,vofi_creal sz[])
+{
+  int n;
+  edg_entry *pe;
+
+  if (j < 0)
+    return;
+  pe = &ped->tab[j];
+  pe->nz = nz;
+  for (n=0;n<nz;n++)
+    pe->sz[n] = sz[n];
+#pragma omp atomic write seq_cst
+  pe->rdy = 1;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_get_side_intersections, but the intersections of the edge ie *
+ * of the grid are taken from the edge cache, if already computed by another *
+ * cell, else they are computed and kept in the cache                         *
+ * INPUT: pointer to the implicit function, function value at the endpoints  *
+ * fe, starting point x1, direction stdir, grid spacing h0, edge cache ped   *
+ * and index of the edge ie (-1: no cache)                                    *
+ * OUTPUT: nsub: updated number of subdivisions; array lim_intg: updated;     *
+ * ist: success/no room for the limits in lim_intg (0/-1)                     *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_edge_intersections(integrand impl_func,void *userdata,vofi_real fe[],vofi_creal x1[],
+                                 vofi_real lim_intg[],vofi_creal stdir[],vofi_creal h0,
+                                 vofi_int_cpt nsub,edg_data *ped,long int ie)
+{
+  int n,nz;
+  long int j;
+  vofi_real sz[NSEG];
+
+  if (ie < 0)
+    return vofi_get_side_intersections(impl_func,userdata,fe,x1,lim_intg,stdir,h0,nsub);
+
+  nz = vofi_find_edge(ped,ie,sz+1,&j);
+  if (nz < 0) {                        /* not yet computed by a neighbor */
+    nz = 1;
+    vofi_get_side_intersections(impl_func,userdata,fe,x1,sz,stdir,h0,&nz);
+    nz--;
+    vofi_keep_edge(ped,j,nz,sz+1);
+  }
+
+  if (*nsub > NSEG-3)               /* no room for two more limits and h0 */
+    return -1;
+  for (n=0;n<nz;n++) {
+    lim_intg[*nsub] = sz[n+1];
+    (*nsub)++;
+  }
+
+  return 0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * get the extra limits in a face with the four vertices of the same sign: a *
+ * minimum of opposite sign is searched in the face, then the two limits of  *
+ * the interface along the tertiary direction; with the edge cache the face  *
+ * is searched only by the first of its two cells, see vofi_find_edge         *
+ * INPUT: pointer to the implicit function, function value at the vertices   *
+ * fv, minor vertex of the face x1, secondary and tertiary directions sdir    *
+ * and tdir, grid spacing h0, edge cache ped and index of the face ie (-1: no *
+ * cache)                                                                     *
+ * OUTPUT: nsub: updated number of subdivisions; array lim_intg: updated;     *
+ * ist: success/no room for the limits in lim_intg (0/-1)                     *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_face_limits(integrand impl_func,void *userdata,vofi_creal fv[],vofi_creal x1[],
+                          vofi_real lim_intg[],vofi_creal sdir[],vofi_creal tdir[],vofi_creal h0,
+                          vofi_int_cpt nsub,edg_data *ped,long int ie)
+{
+  int n,nz;
+  long int j;
+  vofi_real sz[NSEG];
+  chk_data fvga; 
+  min_data xfsa;
+
+  j = -1;
+  nz = (ie < 0) ? -1 : vofi_find_edge(ped,ie,sz+1,&j);
+  if (nz < 0) {
+    nz = 1;
+    xfsa.iat = 0;
+    fvga = vofi_check_face_consistency(impl_func,userdata,fv,x1,sdir,tdir,h0); 
+    if (fvga.iat != 0)
+      xfsa = vofi_get_face_min(impl_func,userdata,x1,sdir,tdir,fvga,h0);
+    if (xfsa.iat != 0)
+      vofi_get_face_intersections(impl_func,userdata,xfsa,x1,sz,sdir,tdir,h0,&nz);
+    nz--;
+    vofi_keep_edge(ped,j,nz,sz+1);
+  }
+
+  if (*nsub > NSEG-3)               /* no room for two more limits and h0 */
+    return -1;
+  for (n=0;n<nz;n++) {
+    lim_intg[*nsub] = sz[n+1];
+    (*nsub)++;
+  }
+
+  return 0;
+}
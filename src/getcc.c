@@ -29,30 +29,186 @@
 
 /* -------------------------------------------------------------------------- *
  * DESCRIPTION:                                                               *
- * Driver to compute the volume fraction value in a given cell in two and     *
- * three dimensions                                                           *
+ * compute the volume fraction value in a given cell, the cell is first       *
+ * classified with the certified test of vofi_Get_cert, if the optional       *
+ * settings allow it; a quadric of vofi_Get_quadric is integrated exactly     *
+ * with vofi_get_cc_quadric, otherwise the cell is classified with the local  *
+ * grid test of vofi_get_dirs; with opts->cache the f values are kept in a    *
+ * point cache, with opts->stats the evaluations are counted                  *
  * INPUT:  pointer to the implicit function, starting point x0, grid          * 
- * spacing h0, characteristic function value fh, space dimension ndim0        *
- * OUTPUT: cc: volume fraction value                                          *
+ * spacing h0, characteristic function value fh, space dimension ndim0,       *
+ * optional settings opts (may be NULL), edge cache ped of the grid sweep     *
+ * (may be NULL)                                                              *
+ * OUTPUT: cc: volume fraction value, icc: full/empty/cut cell (1/0/-1)       *
  * -------------------------------------------------------------------------- */
 
-vofi_real vofi_Get_cc(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,vofi_creal fh,vofi_cint ndim0)
+vofi_real vofi_get_cc_cell(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                           vofi_creal fh,vofi_cint ndim0,const vofi_opts *opts,edg_data *ped,
+                           vofi_int_cpt icc)
 {
-  int nsub;
-  vofi_real pdir[NDIM],sdir[NDIM],tdir[NDIM],side[NSEG];
+  vofi_creal hbox[NDIM] = {h0,h0,h0};
   vofi_real cc;
+  pch_data pch;
+
+  *icc = vofi_Get_cert(impl_func,userdata,opts,x0,hbox,ndim0);
+  if (*icc >= 0)
+    return (vofi_real) *icc;
+
+  if (impl_func == vofi_Get_quadric) {            /* exact quadric heights */
+    cc = vofi_get_cc_quadric((const vofi_quadric *) userdata,x0,h0,ndim0,icc);
+    if (cc >= 0.)
+      return cc;
+  }
+
+  if (opts == NULL || (!opts->cache && opts->stats == NULL))
+    return vofi_get_cc_sub(impl_func,userdata,x0,h0,fh,ndim0,opts,0,ped,NULL,icc);
+
+  /* the point cache takes the place of the implicit function in the cell */
+  vofi_init_cache(&pch,impl_func,userdata,opts->cache);
+  cc = vofi_get_cc_sub(vofi_get_cache_f,&pch,x0,h0,fh,ndim0,opts,0,ped,NULL,icc);
+  if (opts->stats != NULL) {
+#pragma omp atomic
+    opts->stats->nfunc += pch.nfunc;
+#pragma omp atomic
+    opts->stats->nsave += pch.nsave;
+  }
+
+  return cc;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the volume fraction value in a given cell with the local grid      *
+ * test of vofi_get_dirs and the numerical integration, or with the analytic *
+ * relations of a plane if the function is linear in the cell (opts->plane);  *
+ * with opts->split a cut cell where the interface is not a single graph      *
+ * along the primary direction, or with more than NCUT intersections with     *
+ * the sides, is split into 2 (4, 8) subcells of half size, down to NLEV      *
+ * levels; a cell whose limits (also of an internal plane) do not fit in NSEG *
+ * values is always split, or reported as a failure at the last level (the    *
+ * scratch arrays are on the stack of each level, hence bounded and private   *
+ * to each thread)                                                            *
+ * INPUT:  pointer to the implicit function, starting point x0, grid          *
+ * spacing h0, characteristic function value fh, space dimension ndim0,       *
+ * optional settings opts (may be NULL), level of the cell nlev (0: cell of   *
+ * the grid), edge cache ped of the grid sweep (may be NULL, not used by the  *
+ * subcells), quadrature rules prl of the cell (may be NULL)                  *
+ * OUTPUT: cc: volume fraction value (-1: no room for the limits),            *
+ * icc: full/empty/cut cell (1/0/-1)                                          *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_cc_sub(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                          vofi_creal fh,vofi_cint ndim0,const vofi_opts *opts,vofi_cint nlev,
+                          edg_data *ped,rul_data *prl,vofi_int_cpt icc)
+{
+  int i,j,k,nsub,ksub,icc1,isp,isplit,nvol,nsrf;
+  vofi_real pdir[NDIM],sdir[NDIM],tdir[NDIM],side[NSEG],x1[NDIM];
+  vofi_real cc,cc1,wint;
   dir_data icps; 
 
-  icps = vofi_get_dirs(impl_func,userdata,x0,pdir,sdir,tdir,h0,fh,ndim0);
-  if (icps.icc >= 0)
-    cc = (vofi_real) icps.icc;
-  else {
-    nsub = vofi_get_limits(impl_func,userdata,x0,side,pdir,sdir,tdir,h0,ndim0);
+  icps = vofi_get_dirs(impl_func,userdata,x0,pdir,sdir,tdir,h0,fh,ndim0,opts);
+  *icc = icps.icc;
+  if (icps.icc >= 0) {
+    if (prl != NULL && icps.icc == 1)
+      vofi_add_rule_box(prl,x0,h0,ndim0);
+    return (vofi_real) icps.icc;
+  }
+  if (icps.ipl)                                   /* planar interface */
+    return vofi_get_plane_cc(icps.pln,ndim0);
+
+  isp = (opts != NULL && opts->split && nlev < NLEV);
+  nsub = 0;
+  if (!isp || icps.isb < 2) {           /* no limits if the cell is split */
+    nsub = vofi_get_limits(impl_func,userdata,x0,side,pdir,sdir,tdir,h0,ndim0,ped);
+    if (nsub < 0 && nlev >= NLEV) {
+      fprintf(stderr,"No room for the limits in vofi_get_cc_sub, NSEG: %d \n",NSEG);
+      return -1.;
+    }
+  }
+  isplit = (nsub < 0 || (isp && (icps.isb > 1 || nsub-1 > NCUT)));
+  if (!isplit) {
+    nvol = nsrf = 0;
+    wint = 0.;
+    if (prl != NULL) {               /* rules of the cell, if it is split */
+      wint = prl->wint;
+      if (prl->rule != NULL) {
+	nvol = prl->rule->nvol;
+	nsrf = prl->rule->nsrf;
+      }
+    }
     if (ndim0 == 2) 
-      cc = vofi_get_area(impl_func,userdata,x0,side,pdir,sdir,h0,nsub,icps.ipt);
+      cc = vofi_get_area(impl_func,userdata,x0,side,pdir,sdir,h0,nsub,icps.ipt,prl);
     else 
-      cc =  vofi_get_volume(impl_func,userdata,x0,side,pdir,sdir,tdir,h0,nsub,icps.ipt);
+      cc = vofi_get_volume(impl_func,userdata,x0,side,pdir,sdir,tdir,h0,nsub,icps.ipt,
+                           (opts != NULL && opts->warm),prl);
+    if (cc < 0.) {            /* no room for the limits of an internal plane */
+      if (nlev >= NLEV) {
+	fprintf(stderr,"No room for the limits in vofi_get_cc_sub, NSEG: %d \n",NSEG);
+	return -1.;
+      }
+      if (prl != NULL) {
+	prl->wint = wint;
+	if (prl->rule != NULL) {
+	  prl->rule->nvol = nvol;
+	  prl->rule->nsrf = nsrf;
+	}
+      }
+      isplit = 1;
+    }
+  }
+  if (isplit) {                                            /* split the cell */
+    cc = 0.;
+    ksub = (ndim0 == 2) ? 1 : 2;
+    x1[2] = x0[2];
+    for (k=0;k<ksub;k++)
+      for (j=0;j<2;j++)
+	for (i=0;i<2;i++) {
+	  x1[0] = x0[0] + 0.5*i*h0;
+	  x1[1] = x0[1] + 0.5*j*h0;
+	  if (ndim0 == 3)
+	    x1[2] = x0[2] + 0.5*k*h0;
+	  cc1 = vofi_get_cc_sub(impl_func,userdata,x1,0.5*h0,0.5*fh,ndim0,opts,nlev+1,NULL,
+                                prl,&icc1);
+	  if (cc1 < 0.)
+	    return -1.;
+	  cc += cc1;
+	}
+    cc = cc/(2*2*ksub);
   }
-  
+
   return cc;
 }
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction value in a given cell in two and     *
+ * three dimensions                                                           *
+ * INPUT:  pointer to the implicit function, starting point x0, grid          * 
+ * spacing h0, characteristic function value fh, space dimension ndim0        *
+ * OUTPUT: cc: volume fraction value                                          *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,vofi_creal fh,vofi_cint ndim0)
+{
+  int icc;
+
+  return vofi_get_cc_cell(impl_func,userdata,x0,h0,fh,ndim0,NULL,NULL,&icc);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_Get_cc, but the cell is first classified with the certified  *
+ * test of vofi_Get_cert, if the optional settings allow it                   *
+ * INPUT:  pointer to the implicit function, starting point x0, grid          * 
+ * spacing h0, characteristic function value fh, space dimension ndim0,       *
+ * optional settings opts                                                     *
+ * OUTPUT: cc: volume fraction value                                          *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_opt(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                          vofi_creal fh,vofi_cint ndim0,const vofi_opts *opts)
+{
+  int icc;
+
+  return vofi_get_cc_cell(impl_func,userdata,x0,h0,fh,ndim0,opts,NULL,&icc);
+}
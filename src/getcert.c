@@ -0,0 +1,84 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getcert.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief It certifies that a cell, or a block of cells, is either full 
+ *        or empty with a single evaluation of the implicit function or 
+ *        of its interval extension.
+ */
+
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * certify that the implicit function does not change sign in a box:         *
+ * a) with the interval extension of f, if given, the box is full if          *
+ *    fmax < 0 and empty if fmin > 0;                                         *
+ * b) else with the Lipschitz bound L of f, if given, the box is full/empty   *
+ *    if |f(xc)| > L*r, where xc is the box center and r its half diagonal,   *
+ *    and f(xc) < 0 or f(xc) > 0, respectively                                *
+ * INPUT: pointer to the implicit function, optional settings opts, minor     *
+ * vertex of the box xlo, box sides hbox, space dimension ndim0               *
+ * OUTPUT: icc: full/empty box (1/0) or not certified (-1)                    *
+ * -------------------------------------------------------------------------- */
+
+int vofi_Get_cert(integrand impl_func,void *userdata,const vofi_opts *opts,vofi_creal xlo[],
+                  vofi_creal hbox[],vofi_cint ndim0)
+{
+  int i,icc;
+  vofi_real xl[NDIM],xc[NDIM],xh[NDIM],fr[NEND];
+  vofi_real fc,rd;
+
+  icc = -1;
+  if (opts == NULL)
+    return icc;
+
+  xl[2] = xc[2] = xh[2] = 0.;
+  for (i=0;i<ndim0;i++) {
+    xl[i] = xlo[i];
+    xh[i] = xlo[i] + hbox[i];
+    xc[i] = xlo[i] + 0.5*hbox[i];
+  }
+
+  if (opts->int_func != NULL) {                       /* interval extension */
+    opts->int_func(userdata,xl,xh,fr);
+    if (fr[1] < 0.)
+      icc = 1;
+    else if (fr[0] > 0.)
+      icc = 0;
+  }
+  else if (opts->lip > 0.) {                              /* Lipschitz bound */
+    rd = 0.;
+    for (i=0;i<ndim0;i++)
+      rd += Sq(hbox[i]);
+    rd = 0.5*sqrt(rd);
+    fc = impl_func(userdata,xc);
+    if (fabs(fc) > opts->lip*rd) {
+      if (fc < 0.)
+	icc = 1;
+      else
+	icc = 0;
+    }
+  }
+
+  return icc;
+}
@@ -36,23 +36,30 @@
  *    directions, compute tentative number of integration points along the    * 
  *    secondary direction                                                     *
  * INPUT: pointer to the implicit function, starting point x0, grid spacing   * 
- * h0, characteristic function value fh, space dimension ndim0                *
+ * h0, characteristic function value fh, space dimension ndim0, optional      *
+ * settings opts (may be NULL): with opts->stencil the gradient components    *
+ * are second-order differences of the f values on the local grid, else      *
+ * centred differences with two extra evaluations each; with opts->plane the *
+ * cut cell is first checked for a linear function, see vofi_get_plane       *
  * OUTPUT: pdir, sdir, tdir: primary, secondary, tertiary coord. directions;  *
  * structure icps: icc: full/empty/cut cell (1/0/-1); ipt: tentative number   *
- * of integration points; isb: number of subdivisions, not yet implemented    *
- * (hence: 0/1)                                                               *
+ * of integration points; isb: number of subdivisions along each direction   *
+ * (0/1/2), with opts->split 2 if the gradient component along the primary   *
+ * direction has not the same sign near the interface; ipl: linear function  *
+ * (1/0), pln: its fit, the directions are then not computed                 *
  * -------------------------------------------------------------------------- */
 
 dir_data vofi_get_dirs(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real pdir[],
                        vofi_real sdir[],vofi_real tdir[],vofi_creal h0,vofi_creal fh,vofi_cint
-                       ndim0)
+                       ndim0,const vofi_opts *opts)
 {
-  int i,j,k,m,n,np1,np0,nmax,kmax,jt,js,jp,npt_with_grad;
+  int i,j,k,m,n,np1,np0,nmax,kmax,jt,js,jp,npt_with_grad,istc;
+  int id[NDIM],ia[NDIM];
   int cpos[NDIM],cneg[NDIM];
   vofi_creal dh = 1.e-5;                             /* for 1st deriv. with c.f.d. */
   vofi_creal hh = 0.5*h0;
   vofi_real df0[NLSZ][NLSX][NLSY][NDIM],f0[NLSZ][NLSX][NLSY];
-  vofi_real x1[NDIM],x2[NDIM],xp[NDIM],xm[NDIM],gradf_ave[NDIM];
+  vofi_real x1[NDIM],x2[NDIM],xp[NDIM],xm[NDIM],gradf_ave[NDIM],fs[NLSX];
   vofi_real f1,maxomega,minomega,delomega,tmp,denom;
   dir_data icps;
 
@@ -62,6 +69,7 @@ dir_data vofi_get_dirs(integrand impl_func,void *userdata,vofi_creal x0[],vofi_r
   icps.icc = -1;
   icps.ipt = 0; 
   icps.isb = 1;
+  istc = (opts != NULL && opts->stencil);
   jp = js = jt = npt_with_grad = 0;
   np1 = np0 = 0;
   if (ndim0 == 2) {
@@ -101,8 +109,13 @@ dir_data vofi_get_dirs(integrand impl_func,void *userdata,vofi_creal x0[],vofi_r
     icps.icc = 0;
     icps.isb = 0;
   }
+  /* with opts->plane check if the function is linear in a cut cell */
+  icps.ipl = 0;
+  if (icps.isb == 1 && opts != NULL && opts->plane > 0.)
+    icps.ipl = vofi_get_plane(impl_func,userdata,x2,f0,h0,ndim0,opts->plane,icps.pln);
+
   /* b): if not compute the average gradient near the interface (when |f|<fh) */
-  if (icps.isb == 1) { 
+  if (icps.isb == 1 && icps.ipl == 0) { 
     
     for (i=0;i<NDIM;i++) {
       gradf_ave[i] = pdir[i] = sdir[i] = tdir[i] = 0.;
@@ -119,10 +132,29 @@ dir_data vofi_get_dirs(integrand impl_func,void *userdata,vofi_creal x0[],vofi_r
 	    x1[2] = x2[2] + k*hh;
 	    for (m=0;m<NDIM;m++)
 	      xp[m] = xm[m] = x1[m];    
+	    id[0] = i; id[1] = j; id[2] = k;
 	    for (n=0;n<ndim0;n++) {
-	      xp[n] += dh;
-	      xm[n] -= dh;
-	      df0[k][i][j][n] = 0.5*(impl_func(userdata,xp) - impl_func(userdata,xm))/dh;
+	      if (istc) {        /* second-order differences on the local grid */
+		for (m=0;m<NDIM;m++)
+		  ia[m] = id[m];
+		ia[n] = 0;
+		fs[0] = f0[ia[2]][ia[0]][ia[1]];
+		ia[n] = 1;
+		fs[1] = f0[ia[2]][ia[0]][ia[1]];
+		ia[n] = 2;
+		fs[2] = f0[ia[2]][ia[0]][ia[1]];
+		if (id[n] == 0)
+		  df0[k][i][j][n] = 0.5*(-3.*fs[0] + 4.*fs[1] - fs[2])/hh;
+		else if (id[n] == 1)
+		  df0[k][i][j][n] = 0.5*(fs[2] - fs[0])/hh;
+		else
+		  df0[k][i][j][n] = 0.5*(fs[0] - 4.*fs[1] + 3.*fs[2])/hh;
+	      }
+	      else {
+		xp[n] += dh;
+		xm[n] -= dh;
+		df0[k][i][j][n] = 0.5*(impl_func(userdata,xp) - impl_func(userdata,xm))/dh;
+	      }
 	      gradf_ave[n] += df0[k][i][j][n];  
 	      xp[n] = xm[n] = x1[n];
 	      if (df0[k][i][j][n] > 0.)
@@ -158,6 +190,8 @@ dir_data vofi_get_dirs(integrand impl_func,void *userdata,vofi_creal x0[],vofi_r
       js = k;
       pdir[jp] = sdir[js] = 1.;
     }
+    if (cpos[jp]*cneg[jp] == 1 && opts != NULL && opts->split)
+      icps.isb = 2;                    /* not a single graph: split the cell */
     
     /* get tentative number of integration points along the secondary  
                                 direction (ns=1: no level of subdivision yet) */
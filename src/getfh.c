@@ -27,6 +27,95 @@
 
 #include "vofi_stddecl.h"
 
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Starting from point x0 get a zero of the implicit function given by the    *
+ * user, using gradient ascent/descent                                        *
+ * INPUT:  pointer to the implicit function, starting point x0, space         *
+ * dimension ndim0                                                            *
+ * OUTPUT: xz: zero of the implicit function, iz: found/not found (1/0)       *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_interface_point(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real xz[],vofi_cint ndim0)
+{
+  int i,k,isw;
+  vofi_cint kmax = 100;                             /* max number of iterations    */
+  vofi_creal gamma = 0.01;                          /* min step along the gradient */
+  vofi_creal dh = 1.e-5;                            /* for 1st deriv. with c.f.d.  */
+  vofi_real x1[NDIM],x2[NDIM],xn1[NDIM],xn2[NDIM],der[NDIM],fe[NEND];
+  vofi_real f1,f2,delta,dd;
+
+  isw = 1;
+  x1[2] = x2[2] = xn1[2] = xn2[2] = der[2] = 0.;
+  for (i=0;i<ndim0;i++)                                     /* starting point */
+    x2[i] = x0[i];
+
+  k = 0;
+  f2 = impl_func(userdata,x2);                   /* its f value (should not be zero) */
+  while (fabs(f2) < EPS_NOT0 && k < kmax ) {
+    for (i=0;i<ndim0;i++)
+      x2[i] += dh;
+    f2 = impl_func(userdata,x2);
+    k++;
+  }
+  f1 = f2;
+  if (f1 > 0.)
+    isw = -1;
+
+  /* try to get 2 points with opposite sign of f, by moving along the
+                                         gradient direction with step delta */
+  k = 0;
+  while (f1*f2 >= 0. && k < kmax) {
+    for (i=0;i<ndim0;i++)
+      xn2[i] = xn1[i] = x1[i] = x2[i];     
+    f1 = f2;
+    for (i=0;i<ndim0;i++) {
+      xn2[i] += dh;
+      xn1[i] -= dh;
+      der[i] = 0.5*(impl_func(userdata,xn2)-impl_func(userdata,xn1))/dh;
+      xn2[i] = xn1[i] = x1[i];
+    }
+    /* DEBUG 1 */
+
+    delta = sqrt(Sq3(der));
+    if (delta < EPS_M) {
+      for (i=0;i<ndim0;i++) 
+	der[i] = 1.;
+      delta = sqrt(Sq3(der));
+    }  
+    for (i=0;i<ndim0;i++) 
+      der[i] = der[i]/delta;
+    delta = fabs(f1/delta);
+    delta = MAX(delta,gamma); 
+    for (i=0;i<ndim0;i++) 
+      x2[i] = x1[i] + isw*delta*der[i];    
+    f2 = impl_func(userdata,x2);
+    k++;
+  }
+  /* DEBUG 2 */
+
+  if (k >= kmax) {                                  /* did not get f1*f2 < 0! */
+    fprintf(stderr,"Did not get f1*f2<0, k,kmax: %3d %3d  \n",k,kmax);
+    return 0;
+  }
+
+  /* k<kmax (same as f1*f2 < 0), get the zero on the segment */
+  delta = sqrt(Sqd3(x1,x2) + EPS_NOT0);
+  fe[0] = f1;
+  fe[1] = f2;
+  for (i=0;i<ndim0;i++) 
+    der[i] = (x2[i]-x1[i])/delta;	
+  dd = vofi_get_segment_zero(impl_func,userdata,fe,x1,der,delta,1);
+  for (i=0;i<ndim0;i++) {
+    if (f1 <= f2) 
+      xz[i] = x1[i] + dd*der[i];
+    else
+      xz[i] = x2[i] - dd*der[i];	
+  }
+
+  return 1;
+}
+
 /* -------------------------------------------------------------------------- *
  * DESCRIPTION:                                                               *
  * Starting from point x0 get a zero of the implicit function given by the    *
@@ -40,12 +129,10 @@
 
 vofi_real vofi_Get_fh(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,vofi_cint ndim0,vofi_cint ix0)
 {
-  int i,k,isw;
-  vofi_cint kmax = 100;                             /* max number of iterations    */
-  vofi_creal gamma = 0.01;                          /* min step along the gradient */
+  int i,isw;
   vofi_creal dh = 1.e-5;                            /* for 1st deriv. with c.f.d.  */
-  vofi_real x1[NDIM],x2[NDIM],xn1[NDIM],xn2[NDIM],der[NDIM],fe[NEND];
-  vofi_real f1,f2,fh,delta,dd,hb;
+  vofi_real x1[NDIM],x2[NDIM],xn1[NDIM],xn2[NDIM],der[NDIM];
+  vofi_real f1,f2,fh,dd,hb;
 
   fh = 4.*h0;                                          /* default value of fh */
   isw = 1;
@@ -69,65 +156,10 @@ vofi_real vofi_Get_fh(integrand impl_func,void *userdata,vofi_creal x0[],vofi_cr
       for (i=0;i<ndim0;i++)
 	x2[i] = 0.5;
 
-    k = 0;
-    f2 = impl_func(userdata,x2);                   /* its f value (should not be zero) */
-    while (fabs(f2) < EPS_NOT0 && k < kmax ) {
-      for (i=0;i<ndim0;i++)
-	x2[i] += dh;
-      f2 = impl_func(userdata,x2);
-      k++;
-    }
-    f1 = f2;
-    if (f1 > 0.)
-      isw = -1;
-
-    /* try to get 2 points with opposite sign of f, by moving along the
-                                           gradient direction with step delta */
-    k = 0;
-    while (f1*f2 >= 0. && k < kmax) {
-      for (i=0;i<ndim0;i++)
-	xn2[i] = xn1[i] = x1[i] = x2[i];     
-      f1 = f2;
-      for (i=0;i<ndim0;i++) {
-	xn2[i] += dh;
-	xn1[i] -= dh;
-	der[i] = 0.5*(impl_func(userdata,xn2)-impl_func(userdata,xn1))/dh;
-	xn2[i] = xn1[i] = x1[i];
-      }
-      /* DEBUG 1 */
-
-      delta = sqrt(Sq3(der));
-      if (delta < EPS_M) {
-	for (i=0;i<ndim0;i++) 
-	  der[i] = 1.;
-	delta = sqrt(Sq3(der));
-      }  
-      for (i=0;i<ndim0;i++) 
-	der[i] = der[i]/delta;
-      delta = fabs(f1/delta);
-      delta = MAX(delta,gamma); 
+    /* get a zero of the implicit function */
+    if (vofi_get_interface_point(impl_func,userdata,x2,x1,ndim0)) {
       for (i=0;i<ndim0;i++) 
-	x2[i] = x1[i] + isw*delta*der[i];    
-      f2 = impl_func(userdata,x2);
-      k++;
-    }
-    /* DEBUG 2 */
-
-    /* if k<kmax (same as f1*f2 < 0), get the zero on the segment */
-    if (k < kmax) {
-      delta = sqrt(Sqd3(x1,x2) + EPS_NOT0);
-      fe[0] = f1;
-      fe[1] = f2;
-      for (i=0;i<ndim0;i++) 
-	der[i] = (x2[i]-x1[i])/delta;	
-      dd = vofi_get_segment_zero(impl_func,userdata,fe,x1,der,delta,1);
-      for (i=0;i<ndim0;i++) {
-	if (f1 <= f2) 
-	  x1[i] = x1[i] + dd*der[i];
-	else
-	  x1[i] = x2[i] - dd*der[i];	
 	xn2[i] = xn1[i] = x1[i];
-      }
 
       /* then get the f value at the distance hb from the zero */
       for (i=0;i<ndim0;i++) {
@@ -150,13 +182,10 @@ vofi_real vofi_Get_fh(integrand impl_func,void *userdata,vofi_creal x0[],vofi_cr
       f2 = fabs(impl_func(userdata,xn2));
       fh = MAX(f1,f2);
     }
-    else {                                          /* did not get f1*f2 < 0! */
-      fprintf(stderr,"Did not get f1*f2<0, k,kmax: %3d %3d  \n",k,kmax);
+    else                                            /* did not get f1*f2 < 0! */
       fh = -1.;
-    }
   }
   /* DEBUG 3 */
 
   return fh;
 }
-
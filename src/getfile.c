@@ -0,0 +1,177 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getfile.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief Driver to compute the volume fraction in all cells of a grid, 
+ *        slab by slab, and to write it to a file.
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * write (iwr=1) or read (iwr=0) n bytes at a given offset of a file,         *
+ * retrying after partial transfers and interrupts                            *
+ * INPUT: file descriptor fd, buffer buf, number of bytes n, offset offs,     *
+ * switch iwr                                                                 *
+ * OUTPUT: ist: success/failure (0/-1)                                        *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_file_io(int fd,void *buf,size_t n,long long offs,vofi_cint iwr)
+{
+  char *p = (char *) buf;
+  off_t off = (off_t) offs;
+  ssize_t m;
+
+  while (n > 0) {
+    if (iwr)
+      m = pwrite(fd,p,n,off);
+    else
+      m = pread(fd,p,n,off);
+    if (m < 0 && errno == EINTR)
+      continue;
+    if (m <= 0)
+      return -1;
+    p += m;
+    off += m;
+    n -= (size_t) m;
+  }
+
+  return 0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction in all cells of a grid and to write  *
+ * it to a file, with the same layout of the array cc of vofi_Get_cc_grid     *
+ * (native byte order), the grid is processed in slabs of nblk cells along    *
+ * the last direction (z in 3D, y in 2D), each slab is computed with the      *
+ * hierarchical classification of vofi_Get_cc_grid in a buffer and written   *
+ * at its offset, hence the memory used does not depend on the grid size      *
+ * along that direction; after each slab the number of completed planes is   *
+ * saved in the file fname.rst, that is removed at the end, with irst=1 the  *
+ * computation restarts from the planes completed in a previous call         *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh, name of the output file fname, restart switch irst      *
+ * OUTPUT: vol: total volume of the reference phase (-1 if an I/O error has   *
+ * occurred)                                                                  *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_file(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                           const char *fname,vofi_cint irst)
+{
+  int n,fd,ld,nz,nd,nk,kp,kdone;
+  long int m,np;
+  size_t nb;
+  long long off;
+  vofi_real vol,vs,*cc;
+  char *rname,*tname;
+  FILE *fp;
+
+  ld = grid->ndim - 1;                      /* slabs along the last direction */
+  nd = grid->nc[ld];
+  nz = MAX(grid->nblk,1);
+  np = 1;
+  for (n=0;n<ld;n++)
+    np *= grid->nc[n];
+
+  rname = (char *) malloc(strlen(fname) + 9);
+  tname = (char *) malloc(strlen(fname) + 9);
+  cc = (vofi_real *) malloc(np*MIN(nz,nd)*sizeof(vofi_real));
+  if (rname == NULL || tname == NULL || cc == NULL) {
+    fprintf(stderr,"Out of memory in vofi_Get_cc_file \n");
+    free(rname);
+    free(tname);
+    free(cc);
+    return -1.;
+  }
+  sprintf(rname,"%s.rst",fname);
+  sprintf(tname,"%s.rst.tmp",fname);
+
+  kdone = 0;                                   /* planes already completed */
+  if (irst) {
+    fp = fopen(rname,"r");
+    if (fp != NULL) {
+      if (fscanf(fp,"%d",&kdone) != 1 || kdone < 0 || kdone > nd)
+	kdone = 0;
+      fclose(fp);
+    }
+  }
+
+  if (kdone > 0)
+    fd = open(fname,O_RDWR);
+  else
+    fd = open(fname,O_RDWR | O_CREAT | O_TRUNC,0644);
+  if (fd < 0 || (kdone == 0 && ftruncate(fd,(off_t) np*nd*sizeof(vofi_real)) != 0)) {
+    fprintf(stderr,"Cannot open the file %s: %s \n",fname,strerror(errno));
+    if (fd >= 0)
+      close(fd);
+    free(rname);
+    free(tname);
+    free(cc);
+    return -1.;
+  }
+
+  vol = 0.;
+  for (kp=0;kp<nd;kp+=nz) {
+    nk = MIN(nz,nd-kp);
+    nb = np*nk*sizeof(vofi_real);
+    off = (long long) np*kp*sizeof(vofi_real);
+    if (kp + nk <= kdone) {          /* completed slab: get back its volume */
+      if (vofi_get_file_io(fd,cc,nb,off,0) != 0)
+	break;
+      vs = 0.;
+      for (m=0;m<np*nk;m++)
+	vs += cc[m];
+      vol += vs*pow(grid->h0,grid->ndim);
+    }
+    else {
+      vol += vofi_get_cc_slab(impl_func,userdata,grid,fh,kp,nk,NULL,cc);
+      if (vofi_get_file_io(fd,cc,nb,off,1) != 0 || fsync(fd) != 0)
+	break;
+      fp = fopen(tname,"w");                    /* save the completed planes */
+      if (fp == NULL)
+	break;
+      fprintf(fp,"%d\n",kp + nk);
+      if (fclose(fp) != 0 || rename(tname,rname) != 0)
+	break;
+    }
+  }
+
+  if (kp < nd) {
+    fprintf(stderr,"I/O error on the file %s: %s \n",fname,strerror(errno));
+    vol = -1.;
+  }
+  else
+    remove(rname);
+  close(fd);
+  free(rname);
+  free(tname);
+  free(cc);
+
+  return vol;
+}
@@ -0,0 +1,203 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getfront.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief Driver to compute the volume fraction in all cells of a grid, by
+ *        following the interface from a few seed points.
+ */
+
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * make room for one more cell in the queue of the front driver, by doubling *
+ * its size, so that it grows with the number of cells that are visited      *
+ * INPUT: queue, its size mq and the number of cells nq in the queue          *
+ * OUTPUT: ist: success/failure (0/-1), queue and mq updated                  *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_queue_room(long int **queue,long int *mq,long int nq)
+{
+  long int m;
+  void *p;
+
+  if (nq + 1 > *mq) {
+    m = MAX(2*(*mq),nq + 1);
+    if ((p = realloc(*queue,m*sizeof(long int))) == NULL)
+      return -1;
+    *queue = (long int *) p;
+    *mq = m;
+  }
+
+  return 0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction in all cells of a grid: starting     *
+ * from the seed points, get a zero of the implicit function and visit the    *
+ * cells that are connected through a face to a cut cell, then set the cells  *
+ * that have not been visited along each grid line with the value of the      *
+ * last full/empty cell; the intersections of the edges are computed once   *
+ * and shared by the cut cells with the edge cache                            *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh, number of seed points nseed, their coordinates xs       *
+ * (nseed=0: one seed in the center of the grid)                              *
+ * OUTPUT: cc: volume fraction values, vol: total volume of the reference     *
+ * phase (-1 if out of memory)                                                *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_front(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                            vofi_cint nseed,vofi_creal xs[],vofi_real cc[])
+{
+  int i,j,k,n,s,icc,ns,iom,nc[NDIM],ic[NDIM];
+  long int m,m1,ncell,nq,mq,iq,stride[NDIM];
+  vofi_cint ndim0 = grid->ndim;
+  vofi_creal h0 = grid->h0;
+  vofi_real x0[NDIM],xz[NDIM],vol;
+  long int *queue;
+  char *mark;
+  edg_data edg;
+
+  for (n=0;n<NDIM;n++)
+    nc[n] = (n < ndim0) ? grid->nc[n] : 1;
+  stride[0] = 1;
+  stride[1] = nc[0];
+  stride[2] = (long int) nc[0]*nc[1];
+  ncell = stride[2]*nc[2];
+
+  /* the queue grows with the visited cells, from NQUE cells per seed */
+  ns = (nseed > 0) ? nseed : 1;
+  mq = (long int) NQUE*ns;
+  mark = (char *) calloc(ncell,sizeof(char));        /* 0: not visited yet */
+  queue = (long int *) malloc(mq*sizeof(long int));
+  if (mark == NULL || queue == NULL) {
+    fprintf(stderr,"Out of memory in vofi_Get_cc_front, ncell: %ld \n",ncell);
+    free(mark);
+    free(queue);
+    return -1.;
+  }
+
+  /* put in the queue the cells with the zeros close to the seed points */
+  nq = 0;
+  iom = 0;
+  x0[2] = xz[2] = 0.;
+  for (s=0;s<ns && !iom;s++) {
+    for (n=0;n<ndim0;n++)
+      x0[n] = (nseed > 0) ? xs[NDIM*s+n] : grid->x0[n] + 0.5*nc[n]*h0;
+    if (vofi_get_interface_point(impl_func,userdata,x0,xz,ndim0)) {
+      m = 0;
+      for (n=0;n<ndim0;n++) {
+	ic[n] = (int) floor((xz[n] - grid->x0[n])/h0);
+	ic[n] = MAX(0,MIN(nc[n]-1,ic[n]));
+	m += ic[n]*stride[n];
+      }
+      if (!mark[m]) {
+	iom = vofi_get_queue_room(&queue,&mq,nq);
+	mark[m] = 1;
+	if (!iom)
+	  queue[nq++] = m;
+      }
+    }
+  }
+
+  vofi_init_edges(&edg,grid);
+  /* breadth-first visit of the cells connected through a face to a cut
+     cell, mark: 1 in the queue, 2 full/empty, 3 cut cell */
+  for (iq=0;iq<nq && !iom;iq++) {
+    m = queue[iq];
+    ic[0] = m % nc[0];
+    ic[1] = (m / nc[0]) % nc[1];
+    ic[2] = m / stride[2];
+    for (n=0;n<NDIM;n++)
+      x0[n] = grid->x0[n] + ic[n]*h0;
+    cc[m] = vofi_get_cc_cell(impl_func,userdata,x0,h0,fh,ndim0,grid->opts,&edg,&icc);
+    vofi_grow_edges(&edg);
+    if (icc >= 0)
+      mark[m] = 2;
+    else {
+      mark[m] = 3;
+      for (n=0;n<ndim0;n++) 
+	for (k=-1;k<=1;k+=2) 
+	  if (ic[n]+k >= 0 && ic[n]+k < nc[n]) {
+	    m1 = m + k*stride[n];
+	    if (!mark[m1] && !iom) {
+	      iom = vofi_get_queue_room(&queue,&mq,nq);
+	      mark[m1] = 1;
+	      if (!iom)
+		queue[nq++] = m1;
+	    }
+	  }
+    }
+  }
+
+  vofi_free_edges(&edg);
+  if (iom) {
+    fprintf(stderr,"Out of memory in vofi_Get_cc_front, queue: %ld \n",mq);
+    free(mark);
+    free(queue);
+    return -1.;
+  }
+
+  /* cells not visited have no cut cell as neighbor: along each grid line
+     they get the value of the previous (next) full/empty cell, or that of 
+     the previous grid line, only the very first value is given by f */
+  for (k=0;k<nc[2];k++)
+    for (j=0;j<nc[1];j++) {
+      m = stride[1]*j + stride[2]*k;
+      i = 0;
+      while (i < nc[0]) {
+	if (mark[m+i]) {
+	  i++;
+	  continue;
+	}
+	for (n=i;n<nc[0] && !mark[m+n];n++);     /* not visited in [i,n) */
+	if (i > 0)
+	  vol = cc[m+i-1];
+	else if (n < nc[0])
+	  vol = cc[m+n];
+	else if (j > 0)
+	  vol = cc[m-stride[1]];
+	else if (k > 0)
+	  vol = cc[m-stride[2]];
+	else {
+	  for (s=0;s<ndim0;s++)
+	    x0[s] = grid->x0[s] + 0.5*h0;
+	  vol = (impl_func(userdata,x0) < 0.) ? 1. : 0.;
+	}
+	for (;i<n;i++) {
+	  cc[m+i] = vol;
+	  mark[m+i] = 2;
+	}
+      }
+    }
+
+  vol = 0.;
+  for (m=0;m<ncell;m++)
+    vol += cc[m];
+  vol = vol*pow(h0,ndim0);
+
+  free(mark);
+  free(queue);
+
+  return vol;
+}
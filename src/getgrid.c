@@ -0,0 +1,326 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getgrid.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief Driver to compute the volume fraction in all cells of a grid,
+ *        with a hierarchical classification of blocks of cells.
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * initialize the grid structure with the default settings: blocks of NBLK   *
+ * cells along each direction, a single thread, no optional settings          *
+ * INPUT: minor vertex of the grid x0, grid spacing h0, number of cells nc    *
+ * along each direction, space dimension ndim0                                *
+ * OUTPUT: grid structure                                                     *
+ * -------------------------------------------------------------------------- */
+
+void vofi_Set_grid(vofi_grid *grid,vofi_creal x0[],vofi_creal h0,vofi_cint nc[],vofi_cint ndim0)
+{
+  int i;
+
+  for (i=0;i<NDIM;i++) {
+    grid->x0[i] = 0.;
+    grid->nc[i] = 1;
+  }
+  for (i=0;i<ndim0;i++) {
+    grid->x0[i] = x0[i];
+    grid->nc[i] = nc[i];
+  }
+  grid->h0 = h0;
+  grid->ndim = ndim0;
+  grid->nblk = NBLK;
+  grid->nthr = 1;
+  grid->opts = NULL;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the value of the implicit function in a block of cells at the      *
+ * points of the 3x3(x3) local grids of all its cells, i.e. with spacing      *
+ * h0/2, each point with the same coordinates of vofi_get_dirs in the cell;   *
+ * if all f values have the same sign and |f| > fh, then if f > 0 the block   *
+ * is empty, else it is full, and vofi_get_dirs would give the same result  *
+ * in each of its cells                                                       *
+ * INPUT: pointer to the implicit function, grid structure, indices of the    *
+ * first cell of the block ib, number of cells of the block along each        *
+ * direction nb, characteristic function value fh                             *
+ * OUTPUT: icc: full/empty/maybe cut block (1/0/-1)                           *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_block_class(integrand impl_func,void *userdata,const vofi_grid *grid,
+                         vofi_cint ib[],vofi_cint nb[],vofi_creal fh)
+{
+  int i,n,ic,np[NDIM],m[NDIM],isg;
+  vofi_creal h0 = grid->h0;
+  vofi_creal hh = 0.5*h0;
+  vofi_real x1[NDIM],f1;
+
+  for (n=0;n<NDIM;n++)
+    np[n] = (n < grid->ndim) ? 2*nb[n]+1 : 1;
+  isg = 0;
+  x1[2] = 0.;
+  for (m[2]=0;m[2]<np[2];m[2]++)              /* get f values on the h0/2 grid */
+    for (m[0]=0;m[0]<np[0];m[0]++)
+      for (m[1]=0;m[1]<np[1];m[1]++) {
+	for (n=0;n<grid->ndim;n++) {    /* cell ic and point i of its local grid */
+	  ic = MIN(m[n]/2,nb[n]-1);
+	  i = m[n] - 2*ic;
+	  x1[n] = (grid->x0[n] + (ib[n] + ic)*h0) + i*hh;
+	}
+	f1 = impl_func(userdata,x1);
+	if (fabs(f1) <= fh)             /* near the interface: no need to go on */
+	  return -1;
+	if (isg == 0)
+	  isg = (f1 < 0.) ? 1 : -1;
+	else if (isg*f1 > 0.)                                    /* sign change */
+	  return -1;
+      }
+
+  return (isg > 0) ? 1 : 0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * classify a block of cells, with the certified test if the optional         *
+ * settings allow it, else with the local grid test of vofi_get_block_class,  *
+ * if it is full or empty set all its cells, else split it into 2 (4, 8)      *
+ * sub-blocks and repeat, down to the single cell; with the certified test    *
+ * a block that is not certified is split without the local grid test, that   *
+ * would evaluate f at about 2^d points per cell, hence only the cells near   *
+ * the interface are evaluated, and each of them is still classified by       *
+ * vofi_get_cc_cell as cell by cell                                           *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh, indices of the first cell of the block ib, number of    *
+ * cells of the block along each direction nb, strides st of the array cc    *
+ * along each direction, offset m0 of the first value of cc, edge cache ped  *
+ * of the grid sweep (may be NULL)                                            *
+ * OUTPUT: cc: volume fraction values of the cells of the block               *
+ * -------------------------------------------------------------------------- */
+
+void vofi_get_block(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                    vofi_cint ib[],vofi_cint nb[],const long int st[],long int m0,vofi_real cc[],
+                    edg_data *ped)
+{
+  int i,j,k,n,icc,icrt,nbmax,ns[NDIM],ib1[NDIM],nb1[NDIM];
+  vofi_cint ndim0 = grid->ndim;
+  vofi_creal h0 = grid->h0;
+  vofi_real xlo[NDIM],hbox[NDIM];
+  
+  nbmax = 1;
+  xlo[2] = 0.;
+  hbox[2] = h0;
+  for (n=0;n<ndim0;n++) {
+    xlo[n] = grid->x0[n] + ib[n]*h0;
+    hbox[n] = nb[n]*h0;
+    nbmax = MAX(nbmax,nb[n]);
+  }
+
+  if (nbmax == 1) {                                          /* single cell */
+    cc[ib[0]*st[0] + ib[1]*st[1] + ib[2]*st[2] - m0] = 
+      vofi_get_cc_cell(impl_func,userdata,xlo,h0,fh,ndim0,grid->opts,ped,&icc);
+    return;
+  }
+
+  icc = vofi_Get_cert(impl_func,userdata,grid->opts,xlo,hbox,ndim0);
+  icrt = (grid->opts != NULL && (grid->opts->int_func != NULL || grid->opts->lip > 0.));
+  if (icc < 0 && !icrt && impl_func != vofi_Get_quadric) /* quadric: by cells */
+    icc = vofi_get_block_class(impl_func,userdata,grid,ib,nb,fh);
+
+  if (icc >= 0) {                                 /* full/empty: set the cells */
+    for (k=ib[2];k<ib[2]+nb[2];k++)
+      for (j=ib[1];j<ib[1]+nb[1];j++)
+	for (i=ib[0];i<ib[0]+nb[0];i++)
+	  cc[i*st[0] + j*st[1] + k*st[2] - m0] = (vofi_real) icc;
+  }
+  else {                                   /* maybe cut: split into sub-blocks */
+    for (n=0;n<NDIM;n++)
+      ns[n] = (nb[n] > 1) ? 2 : 1;
+    for (k=0;k<ns[2];k++)
+      for (j=0;j<ns[1];j++)
+	for (i=0;i<ns[0];i++) {
+	  ib1[0] = ib[0] + i*((nb[0]+1)/2);
+	  ib1[1] = ib[1] + j*((nb[1]+1)/2);
+	  ib1[2] = ib[2] + k*((nb[2]+1)/2);
+	  nb1[0] = (i == 0) ? (nb[0]+1)/2 : nb[0]/2;
+	  nb1[1] = (j == 0) ? (nb[1]+1)/2 : nb[1]/2;
+	  nb1[2] = (k == 0) ? (nb[2]+1)/2 : nb[2]/2;
+	  vofi_get_block(impl_func,userdata,grid,fh,ib1,nb1,st,m0,cc,ped);
+	}
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the volume fraction in a slab of the grid, with the planes         *
+ * k0 <= k < k0+nk along the last direction (z in 3D, y in 2D): the slab is   *
+ * split into blocks of nblk cells along each direction, that are classified *
+ * from coarse to fine with vofi_get_block, with nthr OpenMP threads if       *
+ * available; the cell coordinates are the same as for the whole grid, hence  *
+ * the values do not depend on the slabs nor on the threads; the threads     *
+ * share an edge cache, whose intersections are computed from the vertices   *
+ * of the grid, hence they do not depend on the cell that computed them; the  *
+ * blocks are processed by layers along the last direction and the cache is   *
+ * aged after each layer, so that it keeps only the last two layers           *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh, first plane k0 and number of planes nk of the slab,     *
+ * strides st of the array cc along each direction (NULL: contiguous array)   *
+ * OUTPUT: cc: volume fraction values of the slab, starting from the first    *
+ * cell of plane k0, vol: volume of the reference phase in the slab           *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_cc_slab(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                           vofi_cint k0,vofi_cint nk,const long int st[],vofi_real cc[])
+{
+  vofi_real vol;
+  edg_data edg;
+
+  vofi_init_edges(&edg,grid);
+  vol = vofi_get_cc_edges(impl_func,userdata,grid,fh,k0,nk,st,cc,&edg);
+  vofi_free_edges(&edg);
+
+  return vol;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_get_cc_slab, but with the edge cache of the caller, that      *
+ * keeps the intersections of the edges of the grid after the sweep (of the   *
+ * last two layers, or all of them with ped->keep)                            *
+ * INPUT: pointer to the implicit function, grid structure, characteristic    *
+ * function value fh, first plane k0 and number of planes nk of the slab,     *
+ * strides st of the array cc along each direction (NULL: contiguous array),  *
+ * initialized edge cache ped                                                 *
+ * OUTPUT: cc: volume fraction values of the slab, starting from the first    *
+ * cell of plane k0, vol: volume of the reference phase in the slab, ped:     *
+ * updated edge cache                                                         *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_cc_edges(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                            vofi_cint k0,vofi_cint nk,const long int st[],vofi_real cc[],
+                            edg_data *ped)
+{
+  int i,j,k,l,n,ld,nblk,ib[NDIM],nb[NDIM],nc[NDIM],kb[NDIM],ke[NDIM],nbk[NDIM];
+  long int m0,b,nbl,sc[NDIM];
+  vofi_real vol;
+#ifdef _OPENMP
+  int nthr;
+#endif
+
+  nblk = MAX(grid->nblk,1);
+  ld = grid->ndim - 1;
+  for (n=0;n<NDIM;n++) {
+    nc[n] = (n < grid->ndim) ? grid->nc[n] : 1;
+    kb[n] = 0;
+    ke[n] = nc[n];
+  }
+  kb[ld] = k0;
+  ke[ld] = k0 + nk;
+  if (st != NULL)
+    for (n=0;n<NDIM;n++)
+      sc[n] = st[n];
+  else {
+    sc[0] = 1;
+    sc[1] = nc[0];
+    sc[2] = (long int) nc[0]*nc[1];
+  }
+  m0 = k0*sc[ld];
+  nbl = 1;
+  for (n=0;n<NDIM;n++) {                        /* number of blocks in the slab */
+    nbk[n] = (ke[n] - kb[n] + nblk - 1)/nblk;
+    if (n != ld)
+      nbl *= nbk[n];
+  }
+
+#ifdef _OPENMP
+  nthr = (grid->nthr > 0) ? grid->nthr : omp_get_max_threads();
+#endif
+  for (l=0;l<nbk[ld];l++) {                       /* loop over block layers */
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthr) private(n,b,ib,nb)
+#endif
+    {
+#pragma omp for schedule(dynamic,1) nowait
+      for (b=l*nbl;b<(l+1)*nbl;b++) {                   /* loop over blocks */
+	ib[0] = kb[0] + (int) (b % nbk[0])*nblk;
+	ib[1] = kb[1] + (int) ((b / nbk[0]) % nbk[1])*nblk;
+	ib[2] = kb[2] + (int) (b / ((long int) nbk[0]*nbk[1]))*nblk;
+	for (n=0;n<NDIM;n++)
+	  nb[n] = MIN(nblk,ke[n]-ib[n]);
+	vofi_get_block(impl_func,userdata,grid,fh,ib,nb,sc,m0,cc,ped);
+      }
+    }
+    vofi_age_edges(ped);
+  }
+
+  vol = 0.;
+  for (k=kb[2];k<ke[2];k++)
+    for (j=kb[1];j<ke[1];j++)
+      for (i=kb[0];i<ke[0];i++)
+	vol += cc[i*sc[0] + j*sc[1] + k*sc[2] - m0];
+  vol = vol*pow(grid->h0,grid->ndim);
+
+  return vol;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction in all cells of a grid: the grid is  *
+ * split into blocks of nblk cells along each direction, that are classified *
+ * from coarse to fine with vofi_get_block                                    *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh                                                          *
+ * OUTPUT: cc: volume fraction values, vol: total volume of the reference     *
+ * phase                                                                      *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_grid(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                           vofi_real cc[])
+{
+  return vofi_get_cc_slab(impl_func,userdata,grid,fh,0,grid->nc[grid->ndim-1],NULL,cc);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_Get_cc_grid, but the volume fraction of cell (i,j,k) is       *
+ * cc[i*st[0] + j*st[1] + k*st[2]], e.g. for a section of a larger array or   *
+ * for an array with ghost cells                                              *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh, strides st of the array cc along each direction         *
+ * OUTPUT: cc: volume fraction values, vol: total volume of the reference     *
+ * phase                                                                      *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_strided(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                              const long int st[],vofi_real cc[])
+{
+  return vofi_get_cc_slab(impl_func,userdata,grid,fh,0,grid->nc[grid->ndim-1],st,cc);
+}
@@ -21,9 +21,10 @@
  * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
  *          Philip Yecko and Stephane Zaleski 
  * @date  12 November 2015
- * @brief It contains two functions to compute the interface
- *        intersection(s) with a cell side and inside a face,
- *        these are internal/external limits of integration.
+ * @brief It contains the functions to compute the interface
+ *        intersection(s) with a cell side, also a single one near
+ *        a guess of its position, and inside a face, these are 
+ *        internal/external limits of integration.
  */
 
 
@@ -36,10 +37,11 @@
  * INPUT: pointer to the implicit function, function value at the endpoints   *
  * fe, starting point x0, direction stdir, grid spacing h0                    *
  * OUTPUT: nsub: updated number of subdivisions; array lim_intg: updated      *
- * start of new subdivisions                                                  *
+ * start of new subdivisions; ist: success/no room for two more limits and h0 *
+ * in lim_intg (0/-1)                                                         *
  * -------------------------------------------------------------------------- */
 
-void vofi_get_side_intersections(integrand impl_func,void *userdata,vofi_real fe[],vofi_creal x0[],
+int vofi_get_side_intersections(integrand impl_func,void *userdata,vofi_real fe[],vofi_creal x0[],
                                  vofi_real lim_intg[],vofi_creal stdir[],vofi_creal h0,vofi_int_cpt
                                  nsub)
 {
@@ -48,6 +50,9 @@ void vofi_get_side_intersections(integrand impl_func,void *userdata,vofi_real fe
   vofi_real dh0,fh0,ss;    
   min_data xfsa;
   
+  if (*nsub > NSEG-3)               /* no room for two more limits and h0 */
+    return -1;
+
   if (fe[0]*fe[1] < 0.0) {
     dh0 = vofi_get_segment_zero(impl_func,userdata,fe,x0,stdir,h0,true_sign);
     if (fe[0] > 0.0)
@@ -79,7 +84,82 @@ void vofi_get_side_intersections(integrand impl_func,void *userdata,vofi_real fe
     }
   }
     
-  return;
+  return 0;
+}    
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the single interface intersection with a given cell side, whose    *
+ * start has the sign of fs: the zero is bracketed by the segment of half-    *
+ * width dg around the guess sg, or by the part of the side on the proper     *
+ * side of the segment; if f at the start of the side has changed sign, the   *
+ * number of intersections may have changed too and the side must be          *
+ * searched with vofi_get_side_intersections                                  *
+ * INPUT: pointer to the implicit function, starting point x0, direction      *
+ * stdir, grid spacing h0, guess sg and half-width dg of the bracket, f value *
+ * at the start of the side fs                                                *
+ * OUTPUT: sz: position of the intersection along the side; ist: success/the  *
+ * sign at the start of the side has changed (0/-1)                           *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_side_zero(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal stdir[],
+                       vofi_creal h0,vofi_creal sg,vofi_creal dg,vofi_creal fs,vofi_real *sz)
+{
+  int i;
+  vofi_cint true_sign=1;
+  vofi_real xs[NDIM],fe[NEND],sa,sb,fa,fb,dh0;
+
+  sa = MAX(sg-dg,0.);
+  sb = MIN(sg+dg,h0);
+  for (i=0;i<NDIM;i++)
+    xs[i] = x0[i] + sa*stdir[i];
+  fa = impl_func(userdata,xs);
+  if (fa == 0.) {
+    *sz = sa;
+    return (sa > 0.) ? 0 : -1;
+  }
+  if (fa*fs < 0.) {                                   /* zero in [0,sa] */
+    if (sa == 0.)
+      return -1;
+    fb = fa;
+    sb = sa;
+    sa = 0.;
+    fa = impl_func(userdata,x0);
+    if (fa*fs <= 0.)
+      return -1;
+  }
+  else {
+    for (i=0;i<NDIM;i++)
+      xs[i] = x0[i] + sb*stdir[i];
+    fb = impl_func(userdata,xs);
+    if (fb*fs > 0.) {                                 /* zero in [sb,h0] */
+      if (sb == h0)
+	return -1;
+      sa = sb;
+      fa = fb;
+      sb = h0;
+      for (i=0;i<NDIM;i++)
+	xs[i] = x0[i] + h0*stdir[i];
+      fb = impl_func(userdata,xs);
+      if (fb*fs >= 0.)
+	return -1;
+    }
+  }
+  if (fb == 0.) {
+    *sz = sb;
+    return 0;
+  }
+
+  for (i=0;i<NDIM;i++)
+    xs[i] = x0[i] + sa*stdir[i];
+  fe[0] = fa;
+  fe[1] = fb;
+  dh0 = vofi_get_segment_zero(impl_func,userdata,fe,xs,stdir,sb-sa,true_sign);
+  if (fe[0] > 0.0)
+    dh0 = sb - sa - dh0;
+  *sz = sa + dh0;
+    
+  return 0;
 }    
 
 /* -------------------------------------------------------------------------- *
@@ -89,10 +169,11 @@ void vofi_get_side_intersections(integrand impl_func,void *userdata,vofi_real fe
  * with negative f value and function sign attribute, starting point x0,      * 
  * secondary and tertiary directions sdir and tdir, grid spacing h0           *
  * OUTPUT: nsub: updated number of subdivisions; array lim_intg: updated      *
- * start of new subdivisions                                                  *
+ * start of new subdivisions; ist: success/no room for two more limits and h0 *
+ * in lim_intg (0/-1)                                                         *
  * -------------------------------------------------------------------------- */
 
-void vofi_get_face_intersections(integrand impl_func,void *userdata,min_data xfsa,vofi_creal
+int vofi_get_face_intersections(integrand impl_func,void *userdata,min_data xfsa,vofi_creal
                                  x0[],vofi_real lim_intg[],vofi_creal sdir[],vofi_creal tdir[],
                                  vofi_creal h0,vofi_int_cpt nsub)
 {
@@ -103,6 +184,9 @@ void vofi_get_face_intersections(integrand impl_func,void *userdata,min_data xfs
   vofi_real ss0,ds0,fpt0,sss,sst,ssx,ssy,tol2,normdir,d1,d2,a1,a2;
   vofi_creal tol = EPS_M; 
  
+  if (*nsub > NSEG-3)               /* no room for two more limits and h0 */
+    return -1;
+
   /* GRAPHICS I */
   tol2 = 2.*tol;
   for (i=0;i<NDIM;i++)
@@ -275,5 +359,5 @@ void vofi_get_face_intersections(integrand impl_func,void *userdata,min_data xfs
     (*nsub)++;
   }
 
-  return;
+  return 0;
 }
@@ -34,30 +34,35 @@
  * rectangles/rectangular hexahedra with or without the interface             *
  * INPUT: pointer to the implicit function, starting point x0, primary,       *
  * secondary, tertiary directions pdir, sdir, tdir, grid spacing h0,          *
- * subdivision direction stdir (2/3)                                          *
- * OUTPUT: nsub: total number of subdivisions; array lim_intg: start/end of   *
- * each subdivision (lim_intg[0] = 0, lim_intg[nsub] = h0)                    *
+ * subdivision direction stdir (2/3), edge cache ped of the grid sweep (may   *
+ * be NULL): the intersections of the sides and the limits in the faces are   *
+ * shared with the neighbors                                                  *
+ * OUTPUT: nsub: total number of subdivisions (-1: no room for the limits in  *
+ * lim_intg); array lim_intg: start/end of each subdivision (lim_intg[0] = 0, *
+ * lim_intg[nsub] = h0)                                                       *
  * -------------------------------------------------------------------------- */
 
 int vofi_get_limits(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real lim_intg[],vofi_creal
-                    pdir[],vofi_creal sdir[],vofi_creal tdir[],vofi_creal h0,vofi_cint stdir)
+                    pdir[],vofi_creal sdir[],vofi_creal tdir[],vofi_creal h0,vofi_cint stdir,
+                    edg_data *ped)
 {
   int i,j,k,iv,nsub,nvp,nvn;
-  vofi_real fv[NVER],x1[NDIM],x2[NDIM],fe[NEND],ds,ls;
-  chk_data fvga; 
-  min_data xfsa;
+  long int ie;
+  vofi_real fv[NVER],x1[NDIM],x2[NDIM],fe[NEND];
   
   lim_intg[0] = 0.;
   nsub = 1;  
   if (stdir == 2) {                     /* get the internal limits along sdir */
     for (j=0;j<2;j++) {                                          /* two sides */
-      for (i=0;i<NDIM;i++) {
+      for (i=0;i<NDIM;i++) 
 	x1[i] = x0[i] + j*pdir[i]*h0;
+      ie = vofi_get_edge_index(ped,x1,sdir);
+      for (i=0;i<NDIM;i++) 
 	x2[i] = x1[i] + sdir[i]*h0;
-      }
       fe[0] = impl_func(userdata,x1);
       fe[1] = impl_func(userdata,x2);
-      vofi_get_side_intersections(impl_func,userdata,fe,x1,lim_intg,sdir,h0,&nsub);
+      if (vofi_get_edge_intersections(impl_func,userdata,fe,x1,lim_intg,sdir,h0,&nsub,ped,ie) < 0)
+	return -1;
     }
   }
   else {                                /* get the external limits along tdir */
@@ -68,10 +73,11 @@ int vofi_get_limits(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real
       for (j=0;j<2;j++) {                                        /* two sides */
 	/* DEBUG 2 */
 
-	for (i=0;i<NDIM;i++) { 
+	for (i=0;i<NDIM;i++) 
 	  x1[i] = x0[i] + k*pdir[i]*h0+j*sdir[i]*h0;
+	ie = vofi_get_edge_index(ped,x1,tdir);
+	for (i=0;i<NDIM;i++) 
 	  x2[i] = x1[i] + tdir[i]*h0;
-	}
 	fe[0] = impl_func(userdata,x1);
 	fv[iv++] = fe[0];
 	fe[1] = impl_func(userdata,x2);
@@ -82,22 +88,19 @@ int vofi_get_limits(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real
 	  else
 	    nvn += 2;
 	}
-	vofi_get_side_intersections(impl_func,userdata,fe,x1,lim_intg,tdir,h0,&nsub);
+	if (vofi_get_edge_intersections(impl_func,userdata,fe,x1,lim_intg,tdir,h0,&nsub,ped,ie) < 0)
+	  return -1;
 	/* DEBUG 3 */
 
       }
       if (nvp == 4 || nvn == 4) {         /* get the extra limits in the face */
 	/* DEBUG 4 */
 
-	xfsa.iat = 0;
 	for (i=0;i<NDIM;i++) 
 	  x1[i] = x0[i] + k*pdir[i]*h0;
-	fvga = vofi_check_face_consistency(impl_func,userdata,fv,x1,sdir,tdir,h0); 
-	if (fvga. iat != 0)
-	  xfsa = vofi_get_face_min(impl_func,userdata,x1,sdir,tdir,fvga,h0);
-	if (xfsa.iat != 0)
-	  vofi_get_face_intersections(impl_func,userdata,xfsa,x1,lim_intg,sdir,tdir,h0,
-                                      &nsub);
+	ie = vofi_get_face_index(ped,x1,pdir,tdir);
+	if (vofi_get_face_limits(impl_func,userdata,fv,x1,lim_intg,sdir,tdir,h0,&nsub,ped,ie) < 0)
+	  return -1;
 	/* DEBUG 5 */
 
       } 
@@ -107,6 +110,292 @@ int vofi_get_limits(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real
 
   /* DEBUG 6 */
 
+  nsub = vofi_sort_limits(lim_intg,h0,nsub);
+  /* DEBUG 7 */
+
+  return nsub;    
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_get_limits along the secondary direction, for a plane of the  *
+ * external integration of a rectangular hexahedron at coordinate t along the *
+ * tertiary direction: the ends of the two sides are on the edges along tdir, *
+ * whose intersections bound the hexahedron, so their sign does not change;   *
+ * a single intersection of a side with the previous planes is extrapolated   *
+ * linearly from the last two (or moved with a unit slope from the last one)  *
+ * and bracketed around the new guess by vofi_get_side_zero; the side is      *
+ * searched from scratch in the first plane, with zero or two intersections,  *
+ * or if the sign at its start has changed                                    *
+ * INPUT: pointer to the implicit function, starting point x0, primary and    *
+ * secondary directions pdir and sdir, grid spacing h0, plane coordinate t,   *
+ * structure with the intersections of the previous planes pld                *
+ * OUTPUT: nsub: total number of subdivisions (-1: no room for the limits in  *
+ * lim_intg); array lim_intg: start/end of each subdivision (lim_intg[0] = 0, *
+ * lim_intg[nsub] = h0); pld: updated                                         *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_limits_inner(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real lim_intg[],
+                          vofi_creal pdir[],vofi_creal sdir[],vofi_creal h0,vofi_creal t,
+                          lim_data *pld)
+{
+  int i,j,n,ist,nsub;
+  vofi_real x1[NDIM],x2[NDIM],fe[NEND],sg,dg;
+
+  lim_intg[0] = 0.;
+  nsub = 1;  
+  for (j=0;j<2;j++) {                                            /* two sides */
+    for (i=0;i<NDIM;i++) 
+      x1[i] = x0[i] + j*pdir[i]*h0;
+    n = pld->nz[j];
+    ist = -1;
+    if (n > 0) {                          /* guess from the previous planes */
+      if (n == 1) {
+	sg = pld->sz[j][0];
+	dg = fabs(t - pld->tz[j][0]);
+      }
+      else {
+	sg = pld->sz[j][1] + (pld->sz[j][1] - pld->sz[j][0])*
+	  (t - pld->tz[j][1])/(pld->tz[j][1] - pld->tz[j][0]);
+	dg = 0.1*fabs(sg - pld->sz[j][1]);
+      }
+      dg = MAX(dg,EPS_M*h0);
+      ist = vofi_get_side_zero(impl_func,userdata,x1,sdir,h0,sg,dg,pld->fs[j],&lim_intg[nsub]);
+      if (ist == 0)
+	nsub++;
+    }
+    if (ist < 0) {                                  /* search the whole side */
+      n = 0;
+      for (i=0;i<NDIM;i++) 
+	x2[i] = x1[i] + sdir[i]*h0;
+      fe[0] = impl_func(userdata,x1);
+      fe[1] = impl_func(userdata,x2);
+      pld->fs[j] = fe[0];
+      if (fe[0]*fe[1] < 0.)
+	ist = 0;
+      if (vofi_get_side_intersections(impl_func,userdata,fe,x1,lim_intg,sdir,h0,&nsub) < 0)
+	return -1;
+    }
+    if (ist == 0) {                        /* single intersection: keep it */
+      if (n == 2) {
+	pld->sz[j][0] = pld->sz[j][1];
+	pld->tz[j][0] = pld->tz[j][1];
+	n = 1;
+      }
+      pld->sz[j][n] = lim_intg[nsub-1];
+      pld->tz[j][n] = t;
+      pld->nz[j] = n + 1;
+    }
+    else
+      pld->nz[j] = 0;
+  }
+  lim_intg[nsub] = h0;
+
+  return vofi_sort_limits(lim_intg,h0,nsub);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_get_limits, but in the reference simplex {xi >= 0, sum(xi) <= *
+ * h0} of an affine map: along the secondary direction in the triangle at x0, *
+ * the columns along pdir end at its bottom side and at its hypotenuse from   *
+ * x0 + h0*pdir along sdir - pdir, whose intersections are the limits; along  *
+ * the tertiary direction the vertices of the triangle of a plane move on the *
+ * three edges through the apex x0 + h0*tdir, and the columns end at the      *
+ * faces p = 0 and p + s + t = h0, searched as in vofi_get_face_limits if     *
+ * the four vertices of their square have the same sign; the hypotenuse face  *
+ * is mapped onto a face of a reference cube, to keep the face algorithm,     *
+ * which works along the coordinate directions                                *
+ * INPUT: pointer to the implicit function, starting point x0, primary,       *
+ * secondary, tertiary directions pdir, sdir, tdir, side of the simplex h0,   *
+ * subdivision direction stdir (2/3)                                          *
+ * OUTPUT: nsub: total number of subdivisions (-1: no room for the limits in  *
+ * lim_intg); array lim_intg: start/end of each subdivision (lim_intg[0] = 0, *
+ * lim_intg[nsub] = h0)                                                       *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_limits_simplex(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real lim_intg[],
+                            vofi_creal pdir[],vofi_creal sdir[],vofi_creal tdir[],vofi_creal h0,
+                            vofi_cint stdir)
+{
+  int c,i,j,k,ist,nsub,nint,nvp,nvn;
+  vofi_creal xf0[NDIM] = {0.,0.,0.};
+  vofi_creal fsdir[NDIM] = {1.,0.,0.};
+  vofi_creal ftdir[NDIM] = {0.,1.,0.};
+  vofi_real x1[NDIM],x2[NDIM],dir[NDIM],fv[NVER],fc[NVER],fe[NEND],tz;
+  map_data fmp;
+
+  lim_intg[0] = 0.;
+  nsub = 1;
+  if (stdir == 2) {                     /* get the internal limits along sdir */
+    for (j=0;j<2;j++) {                             /* bottom and hypotenuse */
+      for (i=0;i<NDIM;i++) {
+	x1[i] = x0[i] + j*pdir[i]*h0;
+	dir[i] = sdir[i] - j*pdir[i];
+	x2[i] = x1[i] + dir[i]*h0;
+      }
+      fe[0] = impl_func(userdata,x1);
+      fe[1] = impl_func(userdata,x2);
+      if (vofi_get_side_intersections(impl_func,userdata,fe,x1,lim_intg,dir,h0,&nsub) < 0)
+	return -1;
+    }
+  }
+  else {                                /* get the external limits along tdir */
+    for (i=0;i<NDIM;i++)         /* f at x0, x0 + h0*pdir, x0 + h0*sdir, apex */
+      x1[i] = x0[i] + tdir[i]*h0;
+    fc[3] = impl_func(userdata,x1);
+    for (k=0;k<3;k++) {                           /* three edges to the apex */
+      for (i=0;i<NDIM;i++) {
+	x1[i] = x0[i] + h0*((k == 1)*pdir[i] + (k == 2)*sdir[i]);
+	dir[i] = tdir[i] - (k == 1)*pdir[i] - (k == 2)*sdir[i];
+      }
+      fc[k] = impl_func(userdata,x1);
+      fe[0] = fc[k];
+      fe[1] = fc[3];
+      if (vofi_get_side_intersections(impl_func,userdata,fe,x1,lim_intg,dir,h0,&nsub) < 0)
+	return -1;
+    }
+
+    /* map of the hypotenuse face onto the face xi_2 = 0 of a cube */
+    fmp.impl_func = impl_func;
+    fmp.userdata = userdata;
+    fmp.ndim = 3;
+    fmp.hs = h0;
+    for (c=0;c<NMAP;c++)
+      for (i=0;i<NDIM;i++)
+	fmp.xv[c][i] = x0[i] + h0*(pdir[i] + (c & 1)*(sdir[i] - pdir[i]) +
+		       ((c >> 1) & 1)*(tdir[i] - pdir[i]) - ((c >> 2) & 1)*pdir[i]);
+
+    for (k=0;k<2;k++) {                           /* faces p = 0 and p+s+t = h0 */
+      fv[0] = fc[k];
+      fv[1] = fc[3];
+      fv[2] = fc[2];
+      for (i=0;i<NDIM;i++)
+	x1[i] = x0[i] + h0*(sdir[i] + tdir[i] - k*pdir[i]);
+      fv[3] = impl_func(userdata,x1);
+      nvp = nvn = 0;
+      for (j=0;j<NVER;j++) {
+	nvp += (fv[j] > 0.);
+	nvn += (fv[j] < 0.);
+      }
+      if (nvp == NVER || nvn == NVER) {   /* get the extra limits in the face */
+	if (k == 0)
+	  ist = vofi_get_face_limits(impl_func,userdata,fv,x0,lim_intg,sdir,tdir,h0,&nsub,
+                                     NULL,-1);
+	else
+	  ist = vofi_get_face_limits(vofi_get_map_f,&fmp,fv,xf0,lim_intg,fsdir,ftdir,h0,
+                                     &nsub,NULL,-1);
+	if (ist < 0)
+	  return -1;
+      }
+    }
+
+    /* the bottom side and the hypotenuse of a plane may become tangent to
+       the interface between two limits, with their ends of the same sign */
+    lim_intg[nsub] = h0;
+    nsub = vofi_sort_limits(lim_intg,h0,nsub);
+    nint = nsub;
+    for (k=0;k<2;k++)
+      for (j=0;j<nint;j++) {
+	tz = vofi_get_simplex_tangent(impl_func,userdata,x0,pdir,sdir,tdir,h0,k,lim_intg[j],
+                                      lim_intg[j+1]);
+	if (tz > 0.) {
+	  if (nsub > NSEG-2)                  /* no room for one more limit and h0 */
+	    return -1;
+	  lim_intg[nsub+1] = lim_intg[nsub];
+	  lim_intg[nsub] = tz;
+	  nsub++;
+	}
+      }
+  }
+  lim_intg[nsub] = h0;
+
+  return vofi_sort_limits(lim_intg,h0,nsub);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * position along the tertiary direction where the bottom side (k = 0) or     *
+ * the hypotenuse (k = 1) of the planes of the reference tetrahedron becomes  *
+ * tangent to the interface, in the interval [ta,tb] between two external     *
+ * limits: the ends of the side must have the same sign in the interval, the  *
+ * signed minimum of vofi_get_side_min, just inside its ends, must change     *
+ * sign and its zero is found with the regula falsi (Illinois) method         *
+ * INPUT: pointer to the implicit function, starting point x0, primary,       *
+ * secondary, tertiary directions pdir, sdir, tdir, side of the tetrahedron   *
+ * h0, side k (0/1), interval ta, tb                                          *
+ * OUTPUT: tz: position of the tangency (-1: no tangency is found)            *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_simplex_tangent(integrand impl_func,void *userdata,vofi_creal x0[],
+                                   vofi_creal pdir[],vofi_creal sdir[],vofi_creal tdir[],
+                                   vofi_creal h0,vofi_cint k,vofi_creal ta,vofi_creal tb)
+{
+  int i,j,iter,iside,f_sign;
+  vofi_cint max_iter = 50;
+  vofi_real x1[NDIM],x2[NDIM],dir[NDIM],ts[NEND],fm[NEND];
+  vofi_real tol,tz,fz,hz;
+
+  tol = MAX(EPS_M*h0,EPS_R);
+  if (tb - ta < 4.*tol)
+    return -1.;
+  tz = 0.5*(ta + tb);                       /* sign of the ends of the side */
+  hz = h0 - tz;
+  for (i=0;i<NDIM;i++) {
+    dir[i] = sdir[i] - k*pdir[i];
+    x1[i] = x0[i] + tz*tdir[i] + k*hz*pdir[i];
+    x2[i] = x1[i] + hz*dir[i];
+  }
+  fz = impl_func(userdata,x1);
+  if (fz*impl_func(userdata,x2) <= 0.)
+    return -1.;
+  f_sign = (fz > 0.) ? 1 : -1;
+
+  ts[0] = ta + tol;
+  ts[1] = tb - tol;
+  for (j=0;j<NEND;j++) {
+    hz = h0 - ts[j];
+    for (i=0;i<NDIM;i++)
+      x1[i] = x0[i] + ts[j]*tdir[i] + k*hz*pdir[i];
+    fm[j] = vofi_get_side_min(impl_func,userdata,x1,dir,hz,f_sign);
+  }
+  if (fm[0]*fm[1] >= 0.)
+    return -1.;
+
+  iter = iside = 0;
+  while (ts[1] - ts[0] > tol && iter < max_iter) {
+    tz = (ts[0]*fm[1] - ts[1]*fm[0])/(fm[1] - fm[0]);
+    if (tz <= ts[0] || tz >= ts[1])
+      tz = 0.5*(ts[0] + ts[1]);
+    hz = h0 - tz;
+    for (i=0;i<NDIM;i++)
+      x1[i] = x0[i] + tz*tdir[i] + k*hz*pdir[i];
+    fz = vofi_get_side_min(impl_func,userdata,x1,dir,hz,f_sign);
+    j = (fz*fm[0] > 0.) ? 0 : 1;    /* Illinois: halve the value kept twice */
+    if (iside == j)
+      fm[1-j] *= 0.5;
+    iside = j;
+    ts[j] = tz;
+    fm[j] = fz;
+    iter++;
+  }
+
+  return 0.5*(ts[0] + ts[1]);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * order the limits of integration from 0 to h0 and remove the zero-length   *
+ * intervals                                                                  *
+ * INPUT: array lim_intg with nsub subdivisions, grid spacing h0              *
+ * OUTPUT: nsub: updated number of subdivisions; array lim_intg: ordered      *
+ * -------------------------------------------------------------------------- */
+
+int vofi_sort_limits(vofi_real lim_intg[],vofi_creal h0,int nsub)
+{
+  int i,j;
+  vofi_real ds,ls;
+
   for (j=2;j<nsub;j++) {                         /* order limits from 0 to h0 */
     ls = lim_intg[j];
     i = j-1;
@@ -129,7 +418,6 @@ int vofi_get_limits(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real
   }
   lim_intg[0] = 0.;                                        /* just for safety */
   lim_intg[nsub] = h0;
-  /* DEBUG 7 */
 
-  return nsub;    
+  return nsub;
 }
@@ -0,0 +1,468 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getmesh.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the drivers that compute the volume fraction of the
+ *        elements of an unstructured mesh, mapped onto the reference square/cube.
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * initialize the bilinear (trilinear) map of the reference square (cube)     *
+ * onto an element, or onto one of its subcells, given its vertices in the    *
+ * order of VTK: the corners (i,j,k) of the reference cell are                *
+ * xv[i + 2*j + 4*k] of the map;                                              *
+ * a quadrilateral and a hexahedron are a single subcell; a triangle and a    *
+ * tetrahedron are a single simplex, a pyramid two tetrahedra, whose map is   *
+ * affine, with the corners of the parallelogram (parallelepiped) spanned by  *
+ * the edges through the first vertex, so that the simplex is the corner      *
+ * {xi >= 0, sum(xi) <= hs} of the reference cell and the map is never        *
+ * singular; a wedge is split into 3 hexahedra, one for each vertex of its    *
+ * triangles, whose corners are the centroids of the vertex and of the edges  *
+ * and of the triangle through it, since its collapsed map is singular at the *
+ * collapsed edge; with isub = -1 the map of the whole element is built,      *
+ * collapsed at some corners, e.g. for its size                               *
+ * INPUT: pointer to the implicit function, vertices xv (three coordinates    *
+ * each), number of vertices nv: 3, 4 in 2D and 4, 5, 6, 8 in 3D, space       *
+ * dimension ndim0, subcell isub (-1: whole element)                          *
+ * OUTPUT: pmp: map of the subcell, nsub: number of subcells (-1, not a       *
+ * supported element)                                                         *
+ * -------------------------------------------------------------------------- */
+
+int vofi_init_map(map_data *pmp,integrand impl_func,void *userdata,vofi_creal xv[],vofi_cint nv,
+                  vofi_cint ndim0,vofi_cint isub)
+{
+  int c,d,n,nc,nsub,ioff,nsum,ismp;
+  int iv[NVER];
+  vofi_cint ctri[NMAP] = {0,1,2,2,0,0,0,0};
+  vofi_cint cqua[NMAP] = {0,1,3,2,0,0,0,0};
+  vofi_cint ctet[NMAP] = {0,1,2,2,3,3,3,3};
+  vofi_cint cpyr[NMAP] = {0,1,3,2,4,4,4,4};
+  vofi_cint cwdg[NMAP] = {0,1,2,2,3,4,5,5};
+  vofi_cint chex[NMAP] = {0,1,3,2,4,5,7,6};
+  vofi_cint ptet[2][NVER] = {{0,1,2,4},{0,2,3,4}};      /* tetrahedra of a pyramid */
+  vofi_cint *ic;
+
+  if (ndim0 == 2) {
+    ic = (nv == 3) ? ctri : (nv == 4) ? cqua : NULL;
+    nsub = 1;
+  }
+  else {
+    ic = (nv == 4) ? ctet : (nv == 5) ? cpyr : (nv == 6) ? cwdg : (nv == 8) ? chex : NULL;
+    nsub = (nv == 5) ? 2 : (nv == 6) ? 3 : 1;
+  }
+  if (ic == NULL || isub >= nsub)
+    return -1;
+  ismp = (nv == ndim0 + 1 || nv == 5);
+
+  pmp->impl_func = impl_func;
+  pmp->userdata = userdata;
+  pmp->ndim = ndim0;
+  pmp->ismp = 0;
+  nc = 1 << ndim0;
+  if (isub < 0 || (nsub == 1 && !ismp)) {        /* map of the whole element */
+    for (c=0;c<NMAP;c++)
+      for (n=0;n<NDIM;n++)
+	pmp->xv[c][n] = xv[NDIM*ic[c]+n];
+    vofi_get_map_size(pmp);
+    return nsub;
+  }
+
+  if (ismp) {                            /* affine map of a simplex */
+    for (d=0;d<=ndim0;d++)
+      iv[d] = (nv == 5) ? ptet[isub][d] : d;
+    for (c=0;c<nc;c++)
+      for (n=0;n<NDIM;n++) {
+	pmp->xv[c][n] = xv[NDIM*iv[0]+n];
+	for (d=0;d<ndim0;d++)
+	  if ((c >> d) & 1)
+	    pmp->xv[c][n] += xv[NDIM*iv[d+1]+n] - xv[NDIM*iv[0]+n];
+      }
+    pmp->ismp = 1;
+  }
+  else {                     /* wedge: centroids of the bottom and of the top */
+    for (d=0;d<3;d++)
+      iv[d] = d;
+    if (isub > 0) {
+      iv[0] = isub;
+      iv[isub] = 0;
+    }
+    for (c=0;c<nc;c++) {
+      ioff = ((c >> 2) & 1) ? 3 : 0;
+      for (n=0;n<NDIM;n++)
+	pmp->xv[c][n] = xv[NDIM*(iv[0]+ioff)+n];
+      nsum = 1;
+      for (d=0;d<2;d++)
+	if ((c >> d) & 1) {
+	  for (n=0;n<NDIM;n++)
+	    pmp->xv[c][n] += xv[NDIM*(iv[d+1]+ioff)+n];
+	  nsum++;
+	}
+      for (n=0;n<NDIM;n++)
+	pmp->xv[c][n] /= nsum;
+    }
+  }
+  for (c=nc;c<NMAP;c++)
+    for (n=0;n<NDIM;n++)
+      pmp->xv[c][n] = pmp->xv[0][n];
+  vofi_get_map_size(pmp);
+
+  return nsub;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * side hs of the reference square (cube) of a map, the largest distance of   *
+ * the corners from the first one over sqrt(ndim), that is the side of a      *
+ * square (cube) of the same diagonal                                         *
+ * INPUT: map pmp                                                             *
+ * OUTPUT: pmp->hs: side of the reference cell                                *
+ * -------------------------------------------------------------------------- */
+
+void vofi_get_map_size(map_data *pmp)
+{
+  int c,n;
+  vofi_real d2,d2max;
+
+  d2max = 0.;
+  for (c=1;c<(1 << pmp->ndim);c++) {
+    d2 = 0.;
+    for (n=0;n<NDIM;n++)
+      d2 += Sq(pmp->xv[c][n] - pmp->xv[0][n]);
+    d2max = MAX(d2max,d2);
+  }
+  pmp->hs = sqrt(d2max/pmp->ndim);
+  if (pmp->hs < EPS_NOT0)
+    pmp->hs = 1.;
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * point of the element and Jacobian matrix of the map at a point of the      *
+ * reference square (cube)                                                    *
+ * INPUT: map pmp, point xi of the reference cell                             *
+ * OUTPUT: x: point of the element, jac: Jacobian matrix dx[n]/dxi[m] in      *
+ * jac[n][m]                                                                  *
+ * -------------------------------------------------------------------------- */
+
+void vofi_get_map_x(const map_data *pmp,vofi_creal xi[],vofi_real x[],vofi_real jac[][NDIM])
+{
+  int c,d,m,n,nc;
+  vofi_real w[NDIM][NEND],shp,dsh;
+
+  nc = 1 << pmp->ndim;
+  for (d=0;d<NDIM;d++) {
+    w[d][1] = xi[d]/pmp->hs;
+    w[d][0] = 1. - w[d][1];
+  }
+  for (n=0;n<NDIM;n++) {
+    x[n] = 0.;
+    for (m=0;m<NDIM;m++)
+      jac[n][m] = 0.;
+  }
+
+  for (c=0;c<nc;c++) {                        /* loop over the corners */
+    shp = 1.;
+    for (d=0;d<pmp->ndim;d++)
+      shp *= w[d][(c >> d) & 1];
+    for (n=0;n<NDIM;n++)
+      x[n] += shp*pmp->xv[c][n];
+    for (m=0;m<pmp->ndim;m++) {
+      dsh = ((c >> m) & 1) ? 1./pmp->hs : -1./pmp->hs;
+      for (d=0;d<pmp->ndim;d++)
+	if (d != m)
+	  dsh *= w[d][(c >> d) & 1];
+      for (n=0;n<NDIM;n++)
+	jac[n][m] += dsh*pmp->xv[c][n];
+    }
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function at the point of the element mapped from a point of the   *
+ * reference square (cube), the map is passed as the user data                *
+ * INPUT: map pmp, point xi of the reference cell                             *
+ * OUTPUT: f: value of the implicit function                                  *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_map_f(void *pmp,vofi_creal xi[])
+{
+  map_data *pmd = (map_data *) pmp;
+  vofi_real x[NDIM],jac[NDIM][NDIM];
+
+  vofi_get_map_x(pmd,xi,x,jac);
+
+  return pmd->impl_func(pmd->userdata,x);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * absolute value of the Jacobian determinant of the map, the weight of the   *
+ * integration over the reference square (cube), the map is passed as the     *
+ * weight data                                                                *
+ * INPUT: map pmp, point xi of the reference cell                             *
+ * OUTPUT: dj: |det(dx/dxi)|                                                  *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_map_jac(void *pmp,vofi_creal xi[])
+{
+  map_data *pmd = (map_data *) pmp;
+  vofi_real x[NDIM],jac[NDIM][NDIM];
+  vofi_real dj;
+
+  vofi_get_map_x(pmd,xi,x,jac);
+  if (pmd->ndim == 2)
+    dj = jac[0][0]*jac[1][1] - jac[0][1]*jac[1][0];
+  else
+    dj = jac[0][0]*(jac[1][1]*jac[2][2] - jac[1][2]*jac[2][1]) -
+         jac[0][1]*(jac[1][0]*jac[2][2] - jac[1][2]*jac[2][0]) +
+         jac[0][2]*(jac[1][0]*jac[2][1] - jac[1][1]*jac[2][0]);
+
+  return fabs(dj);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the volume fraction of the simplex of an affine map: the           *
+ * reference cell is classified once with the local grid test of              *
+ * vofi_get_dirs, which also gives the directions, then the limits and the    *
+ * heights are computed in the simplex {xi >= 0, sum(xi) <= hs}, whose        *
+ * columns along the primary direction end at its hypotenuse                  *
+ * INPUT: map pmp of the simplex, characteristic function value fh of the     *
+ * reference cell, space dimension ndim0                                      *
+ * OUTPUT: cc: volume fraction of the simplex (-1: no room for the limits),   *
+ * icc: full/empty/cut simplex (1/0/-1)                                       *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_cc_simplex(map_data *pmp,vofi_creal fh,vofi_cint ndim0,vofi_int_cpt icc)
+{
+  int c,d,i,j,n,nv,nsub,ia,ib,nsame,nmax;
+  int iv[NVER];
+  vofi_creal x0[NDIM] = {0.,0.,0.};
+  vofi_real pdir[NDIM],sdir[NDIM],tdir[NDIM],side[NSEG],xs[NVER][NDIM],fv[NVER];
+  vofi_real cc,dl,sl,slmax;
+  dir_data icps;
+
+  icps = vofi_get_dirs(vofi_get_map_f,pmp,x0,pdir,sdir,tdir,pmp->hs,fh,ndim0,NULL);
+  *icc = icps.icc;
+  if (icps.icc >= 0)
+    return (vofi_real) icps.icc;
+
+  nv = ndim0 + 1;
+  for (d=0;d<nv;d++) {                  /* vertices of the simplex */
+    c = (d == 0) ? 0 : 1 << (d-1);
+    for (n=0;n<NDIM;n++)
+      xs[d][n] = pmp->xv[c][n];
+    fv[d] = pmp->impl_func(pmp->userdata,xs[d]);
+  }
+
+  /* primary direction: the edge with the largest slope of f */
+  ia = 0;
+  ib = 1;
+  slmax = -1.;
+  for (i=0;i<nv;i++)
+    for (j=i+1;j<nv;j++) {
+      dl = 0.;
+      for (n=0;n<NDIM;n++)
+	dl += Sq(xs[j][n] - xs[i][n]);
+      sl = fabs(fv[j] - fv[i])/sqrt(dl + EPS_NOT0);
+      if (sl > slmax) {
+	slmax = sl;
+	ia = i;
+	ib = j;
+      }
+    }
+  iv[0] = ia;
+  iv[1] = ib;
+  n = 2;
+  for (d=0;d<nv;d++)
+    if (d != ia && d != ib)
+      iv[n++] = d;
+
+  if (ndim0 == 3) {         /* apex: the vertex that shares its sign the most */
+    nmax = -1;
+    for (j=2;j<nv;j++) {
+      nsame = 0;
+      for (d=0;d<nv;d++)
+	nsame += (fv[d]*fv[iv[j]] > 0.);
+      if (nsame > nmax) {
+	nmax = nsame;
+	c = j;
+      }
+    }
+    if (c == 2) {
+      c = iv[2];
+      iv[2] = iv[3];
+      iv[3] = c;
+    }
+  }
+
+  for (c=0;c<(1 << ndim0);c++)           /* new map: p, s, t along xi_0, 1, 2 */
+    for (n=0;n<NDIM;n++) {
+      pmp->xv[c][n] = xs[iv[0]][n];
+      for (d=0;d<ndim0;d++)
+	if ((c >> d) & 1)
+	  pmp->xv[c][n] += xs[iv[d+1]][n] - xs[iv[0]][n];
+    }
+  vofi_get_map_size(pmp);
+  for (n=0;n<NDIM;n++)
+    pdir[n] = sdir[n] = tdir[n] = 0.;
+  pdir[0] = sdir[1] = tdir[2] = 1.;
+
+  cc = -1.;
+  nsub = vofi_get_limits_simplex(vofi_get_map_f,pmp,x0,side,pdir,sdir,tdir,pmp->hs,ndim0);
+  if (nsub >= 0) {
+    if (ndim0 == 2)
+      cc = vofi_get_area_simplex(vofi_get_map_f,pmp,x0,side,pdir,sdir,pmp->hs,nsub,icps.ipt);
+    else
+      cc = vofi_get_volume_simplex(vofi_get_map_f,pmp,x0,side,pdir,sdir,tdir,pmp->hs,nsub,
+                                   icps.ipt);
+  }
+  if (cc < 0.)
+    fprintf(stderr,"No room for the limits in vofi_get_cc_simplex, NSEG: %d \n",NSEG);
+
+  return cc;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction of an element of an unstructured     *
+ * mesh: the implicit function of each subcell is mapped onto its reference   *
+ * cell; the simplices, whose map is affine, are integrated with              *
+ * vofi_get_cc_simplex and weighted with their volume, the hexahedra of a     *
+ * wedge, and a quadrilateral or a hexahedron, are integrated as a cell of a  *
+ * grid, and the Jacobian determinant of the map is integrated over the       *
+ * reference phase as the weight function of vofi_Get_cc_weight, in the same  *
+ * pass; the volume of the subcell is the integral of the Jacobian            *
+ * determinant over the reference cell with a tensor product rule, exact for  *
+ * these maps                                                                 *
+ * INPUT: pointer to the implicit function, vertices xv of the element (three *
+ * coordinates each, in the order of VTK), number of vertices nv, see         *
+ * vofi_init_map, characteristic function value fh of the size of the         *
+ * element, space dimension ndim0                                             *
+ * OUTPUT: cc: volume fraction value (-1: not a supported element or no room  *
+ * for the limits), vol: area/volume of the element                           *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_elem(integrand impl_func,void *userdata,vofi_creal xv[],vofi_cint nv,
+                           vofi_creal fh,vofi_cint ndim0,vofi_real *vol)
+{
+  int icc,isub,nsub;
+  vofi_creal x0[NDIM] = {0.,0.,0.};
+  vofi_real cc,vint,vsub,hs;
+  map_data map;
+  rul_data rul;
+
+  *vol = 0.;
+  nsub = vofi_init_map(&map,impl_func,userdata,xv,nv,ndim0,-1);
+  if (nsub < 0)
+    return -1.;
+
+  hs = map.hs;
+  vint = 0.;
+  vofi_init_rule(&rul,NULL,NPMAP,ndim0);
+  rul.wfunc = vofi_get_map_jac;
+  rul.wdata = &map;
+  for (isub=0;isub<nsub;isub++) {
+    vofi_init_map(&map,impl_func,userdata,xv,nv,ndim0,isub);
+    if (map.ismp) {               /* constant Jacobian determinant */
+      vsub = vofi_get_map_jac(&map,x0)*((ndim0 == 2) ? Sq(map.hs)/2. : Sq(map.hs)*map.hs/6.);
+      cc = vofi_get_cc_simplex(&map,fh*map.hs/hs,ndim0,&icc);
+      if (cc < 0.)
+	return -1.;
+      vint += cc*vsub;
+    }
+    else {
+      rul.wint = 0.;
+      vofi_add_rule_box(&rul,x0,map.hs,ndim0);        /* volume of the subcell */
+      vsub = rul.wint;
+      rul.wint = 0.;
+      cc = vofi_get_cc_sub(vofi_get_map_f,&map,x0,map.hs,fh*map.hs/hs,ndim0,NULL,0,NULL,&rul,
+                           &icc);
+      if (cc < 0.)
+	return -1.;
+      vint += rul.wint;
+    }
+    *vol += vsub;
+  }
+  if (*vol < EPS_NOT0)
+    return 0.;
+  cc = vint/(*vol);
+
+  return MAX(0.,MIN(1.,cc));
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction of all elements of an unstructured   *
+ * mesh, given by its nodes and the connectivity of the elements, with        *
+ * mesh->nthr OpenMP threads if available (the implicit function must then    *
+ * be thread-safe)                                                            *
+ * INPUT: pointer to the implicit function, mesh structure, characteristic    *
+ * function value fh of the size of the largest elements                      *
+ * OUTPUT: cc: volume fraction values (-1: not a supported element or no      *
+ * room for the limits), ve: area/volume of the elements, vol: total volume   *
+ * of the reference phase                                                     *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_mesh(integrand impl_func,void *userdata,const vofi_mesh *mesh,vofi_creal fh,
+                           vofi_real cc[],vofi_real ve[])
+{
+  int n,p,nv;
+  long int e;
+  vofi_real vol,xv[NMAP*NDIM];
+#ifdef _OPENMP
+  int nthr;
+
+  nthr = (mesh->nthr > 0) ? mesh->nthr : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic,64) num_threads(nthr) private(n,p,nv,xv)
+#endif
+  for (e=0;e<mesh->nelm;e++) {                         /* loop over elements */
+    nv = (int) (mesh->ielm[e+1] - mesh->ielm[e]);
+    if (nv > NMAP) {
+      cc[e] = -1.;
+      ve[e] = 0.;
+      continue;
+    }
+    for (p=0;p<nv;p++)
+      for (n=0;n<NDIM;n++)
+	xv[NDIM*p+n] = mesh->xnod[NDIM*mesh->ivrt[mesh->ielm[e]+p]+n];
+    cc[e] = vofi_Get_cc_elem(impl_func,userdata,xv,nv,fh,mesh->ndim,&ve[e]);
+  }
+
+  vol = 0.;
+  for (e=0;e<mesh->nelm;e++)
+    if (cc[e] > 0.)
+      vol += cc[e]*ve[e];
+
+  return vol;
+}
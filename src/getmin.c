@@ -445,3 +445,38 @@ min_data vofi_get_face_min(integrand impl_func,void *userdata,vofi_creal x0[],vo
   
   return xfsa;
 } 
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * signed minimum of the function in a side, a measure of how far the side    *
+ * is from being cut: it is negative if the sign of f_sign*f changes along    *
+ * the side, otherwise it is the minimum of f_sign*f, at an endpoint or       *
+ * inside the side, with the search of vofi_get_segment_min                   *
+ * INPUT: pointer to the implicit function, starting point x0, direction dir, *
+ * side length h0, sign attribute f_sign                                      *
+ * OUTPUT: fm: minimum of f_sign*f in the side, or a negative value of it     *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_side_min(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal dir[],
+                            vofi_creal h0,vofi_cint f_sign)
+{
+  int i,f_iat;
+  vofi_cint max_iter = 50;
+  vofi_real x1[NDIM],fe[NEND],fm;
+  min_data xfsa;
+
+  for (i=0;i<NDIM;i++)
+    x1[i] = x0[i] + h0*dir[i];
+  fe[0] = impl_func(userdata,x0);
+  fe[1] = impl_func(userdata,x1);
+  fm = MIN(f_sign*fe[0],f_sign*fe[1]);
+  if (fm > 0.) {
+    f_iat = vofi_check_side_consistency(impl_func,userdata,fe,x0,dir,h0);
+    if (f_iat != 0) {
+      xfsa = vofi_get_segment_min(impl_func,userdata,fe,x0,dir,h0,f_iat,max_iter);
+      fm = MIN(fm,f_sign*xfsa.fval);
+    }
+  }
+
+  return fm;
+}
@@ -0,0 +1,171 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getmpi.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief MPI drivers to compute fh and the volume fraction in a 
+ *        domain-decomposed grid, with a reproducible global volume.
+ */
+
+#include "vofi_stddecl.h"
+#include "vofi_mpi.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add a value to a fixed-point number of NLIMB limbs of 32 bits, the limb i  *
+ * has weight 2^(32*(i-NLFR)), the bits below 2^(-32*NLFR) are dropped        *
+ * INPUT: fixed-point number fx, value val                                    *
+ * OUTPUT: updated fixed-point number fx                                      *
+ * -------------------------------------------------------------------------- */
+
+void vofi_add_fixed(long long fx[],vofi_creal val)
+{
+  int i;
+  vofi_real v,c,w;
+
+  v = fabs(val);
+  for (i=NLIMB-1;i>=0;i--) {
+    w = ldexp(1.,32*(i-NLFR));
+    c = floor(v/w);
+    v -= c*w;                                                /* it is exact */
+    fx[i] += (val < 0.) ? -(long long) c : (long long) c;
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * propagate the carries of a fixed-point number so that each limb but the   *
+ * last one is in [0,2^32)                                                    *
+ * INPUT: fixed-point number fx                                               *
+ * OUTPUT: normalized fixed-point number fx                                   *
+ * -------------------------------------------------------------------------- */
+
+void vofi_norm_fixed(long long fx[])
+{
+  int i;
+  long long c;
+  const long long b = 4294967296LL;
+
+  for (i=0;i<NLIMB-1;i++) {
+    c = fx[i]/b;
+    fx[i] -= c*b;
+    if (fx[i] < 0) {
+      fx[i] += b;
+      c--;
+    }
+    fx[i+1] += c;
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * convert a normalized fixed-point number to a real value                    *
+ * INPUT: fixed-point number fx                                               *
+ * OUTPUT: val: its value                                                     *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_fixed(const long long fx[])
+{
+  int i;
+  vofi_real val;
+
+  val = 0.;
+  for (i=0;i<NLIMB;i++)
+    val += ldexp((vofi_real) fx[i],32*(i-NLFR));
+
+  return val;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * collective version of vofi_Get_fh: rank 0 computes fh from its starting    *
+ * point and broadcasts it to all the ranks of the communicator               *
+ * INPUT:  pointer to the implicit function, starting point x0, grid spacing  *
+ * h0, space dimension ndim0, switch ix0 for x0, MPI communicator comm        *
+ * OUTPUT: fh ("characteristic" function value), the same on all ranks        *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_fh_mpi(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                          vofi_cint ndim0,vofi_cint ix0,MPI_Comm comm)
+{
+  int rank;
+  vofi_real fh;
+
+  MPI_Comm_rank(comm,&rank);
+  if (rank == 0)
+    fh = vofi_Get_fh(impl_func,userdata,x0,h0,ndim0,ix0);
+  MPI_Bcast(&fh,1,MPI_DOUBLE,0,comm);
+
+  return fh;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction in all cells of the local sub-box,   *
+ * extended with ng ghost layers, with the whole-grid driver, then sum the    *
+ * volume of the cells of the sub-box in fixed point over all ranks, the sum  *
+ * is exact (up to 2^(-32*NLFR) per cell) and reproducible; each rank uses   *
+ * grid->nthr OpenMP threads, one thread if nthr <= 0                         *
+ * INPUT: pointer to the implicit function, grid structure of the sub-box,    *
+ * number of ghost layers ng, characteristic function value fh, MPI           *
+ * communicator comm                                                          *
+ * OUTPUT: cc: volume fraction values of the extended sub-box, vol: total     *
+ * volume of the reference phase in the whole domain                          *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_mpi(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_cint ng[],
+                          vofi_creal fh,MPI_Comm comm,vofi_real cc[])
+{
+  int i,j,k,n,ne[NDIM],ni[NDIM];
+  long long fx[NLIMB],gx[NLIMB];
+  vofi_grid ext;
+  vofi_real vol;
+
+  ext = *grid;                                /* sub-box with ghost layers */
+  for (n=0;n<NDIM;n++) {
+    ni[n] = (n < grid->ndim) ? ng[n] : 0;
+    ext.x0[n] = grid->x0[n] - ni[n]*grid->h0;
+    ext.nc[n] = grid->nc[n] + 2*ni[n];
+    ne[n] = (n < grid->ndim) ? ext.nc[n] : 1;
+  }
+  if (ext.nthr <= 0)              /* no full thread team on each MPI rank */
+    ext.nthr = 1;
+  vofi_Get_cc_grid(impl_func,userdata,&ext,fh,cc);
+
+  for (n=0;n<NLIMB;n++)
+    fx[n] = 0;
+  for (k=ni[2];k<ne[2]-ni[2];k++)                 /* cells of the sub-box */
+    for (j=ni[1];j<ne[1]-ni[1];j++) {
+      for (i=ni[0];i<ne[0]-ni[0];i++)
+	vofi_add_fixed(fx,cc[i + ne[0]*(j + ne[1]*k)]);
+      vofi_norm_fixed(fx);                           /* keep the limbs small */
+    }
+
+  MPI_Allreduce(fx,gx,NLIMB,MPI_LONG_LONG,MPI_SUM,comm);
+  vofi_norm_fixed(gx);
+  vol = vofi_get_fixed(gx)*pow(grid->h0,grid->ndim);
+
+  return vol;
+}
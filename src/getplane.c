@@ -0,0 +1,181 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getplane.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It checks if the implicit function is linear in a cell and computes
+ *        the volume fraction of a cell cut by a plane.
+ */
+
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * least-squares linear fit of the f values on the 3x3(x3) local grid of      *
+ * vofi_get_dirs, f(u) = f_c + g.(u - 1/2) in the normalized coordinates u    *
+ * of the cell, the function is linear if the distance of all these values,  *
+ * and of two more values inside the cell away from the local grid, from the  *
+ * fit is not larger than tol*(|g_1| + |g_2| + |g_3|); any interface with a   *
+ * kink, like the edge of a polyhedron, is rejected at a vertex of the cell  *
+ * INPUT: pointer to the implicit function, starting point x0, f values on   *
+ * the local grid f0, grid spacing h0, space dimension ndim0, tolerance tol   *
+ * OUTPUT: ipl: linear function (1/0); pln: the fit, g in pln[0..2] and f_c  *
+ * in pln[3]                                                                  *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_plane(integrand impl_func,void *userdata,vofi_creal x0[],vofi_real f0[][NLSX][NLSY],
+                   vofi_creal h0,vofi_cint ndim0,vofi_creal tol,vofi_real pln[])
+{
+  int i,j,k,n,kmax,npt;
+  vofi_creal ag = 0.21132486540518711775;           /* 1/2 - sqrt(3)/6 */
+  vofi_real u[NDIM],x1[NDIM];
+  vofi_real gsum,fl,res;
+
+  kmax = (ndim0 == 2) ? 0 : NLSZ-1;
+  npt = (ndim0 == 2) ? NLSX*NLSY : NLSX*NLSY*NLSZ;
+  for (n=0;n<=NDIM;n++)
+    pln[n] = 0.;
+  u[2] = 0.5;
+
+  for (k=0;k<=kmax;k++)                          /* moments of the f values */
+    for (i=0;i<NLSX;i++)
+      for (j=0;j<NLSY;j++) {
+	u[0] = 0.5*i;
+	u[1] = 0.5*j;
+	if (ndim0 == 3)
+	  u[2] = 0.5*k;
+	pln[NDIM] += f0[k][i][j];
+	for (n=0;n<ndim0;n++)
+	  pln[n] += f0[k][i][j]*(u[n] - 0.5);
+      }
+  pln[NDIM] /= npt;
+  gsum = 0.;
+  for (n=0;n<ndim0;n++) {          /* sum of (u_n - 1/2)^2 on the grid: npt/6 */
+    pln[n] *= 6./npt;
+    gsum += fabs(pln[n]);
+  }
+  if (gsum < EPS_NOT0)
+    return 0;
+
+  res = 0.;
+  for (k=0;k<=kmax;k++)               /* distance from the fit on the grid */
+    for (i=0;i<NLSX;i++)
+      for (j=0;j<NLSY;j++) {
+	fl = pln[NDIM] + pln[0]*(0.5*i - 0.5) + pln[1]*(0.5*j - 0.5);
+	if (ndim0 == 3)
+	  fl += pln[2]*(0.5*k - 0.5);
+	res = MAX(res,fabs(f0[k][i][j] - fl));
+      }
+  if (res > tol*gsum)
+    return 0;
+
+  for (k=0;k<NEND;k++) {           /* and at two points away from the grid */
+    u[0] = u[2] = (k == 0) ? ag : 1. - ag;
+    u[1] = 1. - u[0];
+    x1[2] = 0.;
+    fl = pln[NDIM];
+    for (n=0;n<ndim0;n++) {
+      x1[n] = x0[n] + u[n]*h0;
+      fl += pln[n]*(u[n] - 0.5);
+    }
+    if (fabs(impl_func(userdata,x1) - fl) > tol*gsum)
+      return 0;
+  }
+
+  return 1;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * volume fraction of the region f(u) = f_c + g.(u - 1/2) < 0 of the unit     *
+ * square/cube, with the analytic relations of Scardovelli & Zaleski          *
+ * (J. Comput. Phys. 164, 2000): with the normalized components              *
+ * m_n = |g_n|/(|g_1| + |g_2| + |g_3|) in ascending order the plane is        *
+ * m.u = alpha, the cut volume is computed for alpha <= 1/2 and the          *
+ * symmetry of the cube gives the other half                                  *
+ * INPUT: linear function pln (g in pln[0..2], f_c in pln[3]), space          *
+ * dimension ndim0                                                            *
+ * OUTPUT: cc: volume fraction value                                          *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_plane_cc(vofi_creal pln[],vofi_cint ndim0)
+{
+  int n;
+  vofi_real m[NDIM];
+  vofi_real gsum,alpha,al,m12,mm,pr,tmp,cc;
+
+  gsum = 0.;
+  m[2] = 0.;
+  for (n=0;n<ndim0;n++) {
+    m[n] = fabs(pln[n]);
+    gsum += m[n];
+  }
+  alpha = 0.5 - pln[NDIM]/gsum;
+  if (alpha <= 0.)
+    return 0.;
+  else if (alpha >= 1.)
+    return 1.;
+  for (n=0;n<ndim0;n++)
+    m[n] /= gsum;
+  al = MIN(alpha,1. - alpha);
+
+  if (ndim0 == 2) {
+    if (m[0] > m[1]) {
+      tmp = m[0]; m[0] = m[1]; m[1] = tmp;
+    }
+    pr = MAX(2.*m[0]*m[1],EPS_NOT0);
+    if (al < m[0])
+      cc = al*al/pr;
+    else
+      cc = (al - 0.5*m[0])/m[1];
+  }
+  else {
+    if (m[0] > m[1]) {
+      tmp = m[0]; m[0] = m[1]; m[1] = tmp;
+    }
+    if (m[1] > m[2]) {
+      tmp = m[1]; m[1] = m[2]; m[2] = tmp;
+    }
+    if (m[0] > m[1]) {
+      tmp = m[0]; m[0] = m[1]; m[1] = tmp;
+    }
+    m12 = m[0] + m[1];
+    mm = MIN(m12,m[2]);
+    pr = MAX(6.*m[0]*m[1]*m[2],EPS_NOT0);
+    if (al < m[0])
+      cc = al*al*al/pr;
+    else if (al < m[1])
+      cc = 0.5*al*(al - m[0])/(m[1]*m[2]) + m[0]*m[0]*m[0]/pr;
+    else if (al < mm)
+      cc = (al*al*(3.*m12 - al) + m[0]*m[0]*(m[0] - 3.*al) + 
+	    m[1]*m[1]*(m[1] - 3.*al))/pr;
+    else if (m[2] < m12)
+      cc = (al*al*(3. - 2.*al) + m[0]*m[0]*(m[0] - 3.*al) + 
+	    m[1]*m[1]*(m[1] - 3.*al) + m[2]*m[2]*(m[2] - 3.*al))/pr;
+    else
+      cc = (al - 0.5*m12)/m[2];
+  }
+
+  if (alpha > 0.5)
+    cc = 1. - cc;
+
+  return cc;
+}
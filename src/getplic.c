@@ -0,0 +1,353 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getplic.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the driver that computes the volume fraction of all
+ *        cells of a grid together with the interface of the cut cells, the
+ *        intersections with the cell sides and a plane with the volume
+ *        fraction of the cell.
+ */
+
+#include <string.h>
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * plane of a cut cell, n.(u - 1/2) + d = 0 in the normalized coordinates u   *
+ * of the cell: the unit normal n is the normal of the polygon of the         *
+ * intersections (of the segment between the two extreme intersections in     *
+ * 2D), oriented as the gradient g of the f values at the vertices, or g      *
+ * itself with less than 3 (2) intersections; the offset d is found by        *
+ * bisection so that the volume of the region n.(u - 1/2) + d < 0 of the      *
+ * cell is the volume fraction                                                *
+ * INPUT: gradient g, intersections xp ordered around g, number of            *
+ * intersections npt, space dimension ndim0, volume fraction cc               *
+ * OUTPUT: pln: normal in pln[0..2] and offset in pln[3]                      *
+ * -------------------------------------------------------------------------- */
+
+void vofi_get_plic_plane(vofi_creal g[],vofi_real xp[][NDIM],vofi_cint npt,vofi_cint ndim0,
+                         vofi_creal cc,vofi_real pln[])
+{
+  int i,n,it;
+  vofi_real nv[NDIM],xc[NDIM],a[NDIM],b[NDIM];
+  vofi_real gn,nn,dlo,dhi;
+
+  gn = sqrt(Sq3(g));
+  for (n=0;n<NDIM;n++) 
+    nv[n] = xc[n] = 0.;
+  for (i=0;i<npt;i++)
+    for (n=0;n<NDIM;n++)
+      xc[n] += xp[i][n]/npt;
+
+  if (ndim0 == 2 && npt >= 2) {         /* normal of the extreme segment */
+    nv[0] = xp[npt-1][1] - xp[0][1];
+    nv[1] = xp[0][0] - xp[npt-1][0];
+  }
+  else if (ndim0 == 3 && npt >= 3) {            /* Newell normal of polygon */
+    for (i=0;i<npt;i++) {
+      for (n=0;n<NDIM;n++) {
+	a[n] = xp[i][n] - xc[n];
+	b[n] = xp[(i+1)%npt][n] - xc[n];
+      }
+      nv[0] += a[1]*b[2] - a[2]*b[1];
+      nv[1] += a[2]*b[0] - a[0]*b[2];
+      nv[2] += a[0]*b[1] - a[1]*b[0];
+    }
+  }
+  nn = sqrt(Sq3(nv));
+  if (nn > EPS_NOT0 && nv[0]*g[0] + nv[1]*g[1] + nv[2]*g[2] < 0.)
+    nn = -nn;
+  if (fabs(nn) > EPS_NOT0)
+    for (n=0;n<NDIM;n++)
+      pln[n] = nv[n]/nn;
+  else if (gn > EPS_NOT0)
+    for (n=0;n<NDIM;n++)
+      pln[n] = g[n]/gn;
+  else {
+    pln[0] = 1.;
+    pln[1] = pln[2] = 0.;
+  }
+
+  dhi = 0.;                        /* the volume decreases with the offset */
+  for (n=0;n<ndim0;n++)
+    dhi += 0.5*fabs(pln[n]);
+  dlo = -dhi;
+  for (it=0;it<NPBIS && dhi-dlo > EPS_R;it++) {
+    pln[NDIM] = 0.5*(dlo + dhi);
+    if (vofi_get_plane_cc(pln,ndim0) > cc)
+      dlo = pln[NDIM];
+    else
+      dhi = pln[NDIM];
+  }
+  pln[NDIM] = 0.5*(dlo + dhi);
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * interface of a cut cell: the intersections with the sides of the cell      *
+ * are looked up in the edge cache of the grid sweep, only the sides that     *
+ * were not used by the integration of the cell and of its neighbors are      *
+ * computed (and kept in the cache), an intersection shared by two sides at   *
+ * a vertex is taken once; the intersections are ordered by their angle       *
+ * around the gradient of the f values at the vertices (along the normal      *
+ * of the gradient in 2D) and the plane of the cell is computed               *
+ * INPUT: pointer to the implicit function, edge cache ped, minor vertex x0,  *
+ * grid spacing h0, space dimension ndim0, volume fraction cc                 *
+ * OUTPUT: npt: number of intersections, xp: intersections, pln: plane of     *
+ * the cell (normal in pln[0..2] and offset in pln[3])                        *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_plic_cell(integrand impl_func,void *userdata,edg_data *ped,vofi_creal x0[],
+                       vofi_creal h0,vofi_cint ndim0,vofi_creal cc,vofi_real pln[],
+                       vofi_real xp[][NDIM])
+{
+  int i,j,k,m,n,iv,nv,nsub,npt,idup;
+  long int ie;
+  vofi_real fv[NVER*NEND],x1[NDIM],xc[NDIM],stdir[NDIM],fe[NEND],lim_intg[NSEG];
+  vofi_real g[NDIM],gu[NDIM],t1[NDIM],t2[NDIM],ang[NPLC],tmp;
+
+  nv = 1 << ndim0;                      /* bit n of iv: offset along n */
+  for (iv=0;iv<nv;iv++) {
+    for (n=0;n<NDIM;n++)
+      x1[n] = x0[n] + ((iv >> n) & 1)*h0;
+    vofi_get_vertex_index(ped,x1);
+    fv[iv] = impl_func(userdata,x1);
+  }
+
+  npt = 0;
+  for (n=0;n<NDIM;n++) 
+    g[n] = 0.;
+  for (m=0;m<ndim0;m++) {                            /* sides along m */
+    for (n=0;n<NDIM;n++)
+      stdir[n] = (n == m) ? 1. : 0.;
+    for (iv=0;iv<nv;iv++) {
+      if ((iv >> m) & 1)
+	continue;
+      for (n=0;n<NDIM;n++)
+	x1[n] = x0[n] + ((iv >> n) & 1)*h0;
+      ie = vofi_get_edge_index(ped,x1,stdir);
+      fe[0] = fv[iv];
+      fe[1] = fv[iv | (1 << m)];
+      g[m] += 2.*(fe[1] - fe[0])/nv;
+      nsub = 1;
+      vofi_get_edge_intersections(impl_func,userdata,fe,x1,lim_intg,stdir,h0,&nsub,ped,ie);
+      for (k=1;k<nsub && npt<NPLC;k++) {
+	for (n=0;n<NDIM;n++)
+	  xp[npt][n] = x1[n] + stdir[n]*lim_intg[k];
+	idup = 0;
+	for (j=0;j<npt;j++)
+	  if (Sqd3(xp[j],xp[npt]) < Sq(EPS_E*h0))
+	    idup = 1;
+	if (!idup)
+	  npt++;
+      }
+    }
+  }
+
+  /* unit gradient gu and tangent vectors t1, t2 = gu x t1 */
+  tmp = sqrt(Sq3(g));
+  for (n=0;n<NDIM;n++)
+    gu[n] = (tmp > EPS_NOT0) ? g[n]/tmp : (vofi_real) (n == 0);
+  if (ndim0 == 2) {
+    t1[0] = -gu[1];
+    t1[1] = gu[0];
+    t1[2] = 0.;
+  }
+  else {
+    m = 0;
+    for (n=1;n<NDIM;n++)
+      if (fabs(gu[n]) < fabs(gu[m]))
+	m = n;
+    i = (m+1)%NDIM;
+    j = (m+2)%NDIM;
+    t1[m] = 0.;
+    t1[i] = gu[j];
+    t1[j] = -gu[i];
+    tmp = sqrt(Sq3(t1));
+    for (n=0;n<NDIM;n++)
+      t1[n] /= tmp;
+  }
+  t2[0] = gu[1]*t1[2] - gu[2]*t1[1];
+  t2[1] = gu[2]*t1[0] - gu[0]*t1[2];
+  t2[2] = gu[0]*t1[1] - gu[1]*t1[0];
+
+  for (n=0;n<NDIM;n++)
+    xc[n] = 0.;
+  for (i=0;i<npt;i++)
+    for (n=0;n<NDIM;n++)
+      xc[n] += xp[i][n]/npt;
+  for (i=0;i<npt;i++) {              /* angle (abscissa in 2D) of each point */
+    for (n=0;n<NDIM;n++)
+      x1[n] = xp[i][n] - xc[n];
+    if (ndim0 == 2)
+      ang[i] = x1[0]*t1[0] + x1[1]*t1[1];
+    else
+      ang[i] = atan2(x1[0]*t2[0] + x1[1]*t2[1] + x1[2]*t2[2],
+		     x1[0]*t1[0] + x1[1]*t1[1] + x1[2]*t1[2]);
+  }
+  for (i=1;i<npt;i++)                                   /* insertion sort */
+    for (j=i;j>0 && ang[j-1]>ang[j];j--) {
+      tmp = ang[j]; ang[j] = ang[j-1]; ang[j-1] = tmp;
+      for (n=0;n<NDIM;n++) {
+	tmp = xp[j][n]; xp[j][n] = xp[j-1][n]; xp[j-1][n] = tmp;
+      }
+    }
+
+  vofi_get_plic_plane(g,xp,npt,ndim0,cc,pln);
+
+  return npt;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * make room for one more cut cell and n more points in the PLIC structure,   *
+ * by doubling the size of its arrays                                         *
+ * INPUT: PLIC structure pl, number of new points n                           *
+ * OUTPUT: ist: success/failure (0/-1)                                        *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_plic_room(vofi_plic *pl,vofi_cint n)
+{
+  long int m;
+  void *p;
+
+  if (pl->ncut + 1 > pl->mcut) {
+    m = MAX(2*pl->mcut,pl->ncut + 1);
+    if ((p = realloc(pl->icut,m*sizeof(long int))) == NULL)
+      return -1;
+    pl->icut = (long int *) p;
+    if ((p = realloc(pl->pln,(NDIM+1)*m*sizeof(vofi_real))) == NULL)
+      return -1;
+    pl->pln = (vofi_real *) p;
+    if ((p = realloc(pl->ipt,(m+1)*sizeof(long int))) == NULL)
+      return -1;
+    pl->ipt = (long int *) p;
+    pl->mcut = m;
+  }
+  if (pl->npt + n > pl->mpt) {
+    m = MAX(2*pl->mpt,pl->npt + n);
+    if ((p = realloc(pl->xpt,NDIM*m*sizeof(vofi_real))) == NULL)
+      return -1;
+    pl->xpt = (vofi_real *) p;
+    pl->mpt = m;
+  }
+
+  return 0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction in all cells of a grid, as           *
+ * vofi_Get_cc_grid, and the interface of each cut cell, 0 < cc < 1: the      *
+ * edge cache of the grid sweep is kept, hence the intersections of the       *
+ * sides already used by the integration are not searched again, then each    *
+ * cut cell gets its intersections, ordered around the normal, and a plane    *
+ * with its volume fraction                                                   *
+ * INPUT: pointer to the implicit function, grid structure, characteristic    *
+ * function value fh                                                          *
+ * OUTPUT: cc: volume fraction values, pl: PLIC structure (to be released     *
+ * with vofi_Free_plic), vol: total volume of the reference phase (-1 if out  *
+ * of memory)                                                                 *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_plic(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                        vofi_real cc[],vofi_plic *pl)
+{
+  int i,j,k,n,np,ist,nc[NDIM];
+  long int m;
+  vofi_real vol,x1[NDIM],pln[NDIM+1],xp[NPLC][NDIM];
+  edg_data edg;
+
+  memset(pl,0,sizeof(vofi_plic));
+  pl->ndim = grid->ndim;
+  for (n=0;n<NDIM;n++)
+    nc[n] = (n < grid->ndim) ? grid->nc[n] : 1;
+
+  vofi_init_edges(&edg,grid);
+  edg.keep = 1;                          /* all the edges for the interface */
+  vol = vofi_get_cc_edges(impl_func,userdata,grid,fh,0,grid->nc[grid->ndim-1],NULL,cc,&edg);
+
+  ist = vofi_get_plic_room(pl,0);
+  if (ist == 0)
+    pl->ipt[0] = 0;
+  x1[2] = grid->x0[2];
+  m = 0;
+  for (k=0;k<nc[2] && ist==0;k++)
+    for (j=0;j<nc[1] && ist==0;j++)
+      for (i=0;i<nc[0] && ist==0;i++,m++) {
+	if (cc[m] <= 0. || cc[m] >= 1.)
+	  continue;
+	x1[0] = grid->x0[0] + i*grid->h0;
+	x1[1] = grid->x0[1] + j*grid->h0;
+	if (grid->ndim == 3)
+	  x1[2] = grid->x0[2] + k*grid->h0;
+	np = vofi_get_plic_cell(impl_func,userdata,&edg,x1,grid->h0,grid->ndim,cc[m],pln,xp);
+	vofi_grow_edges(&edg);
+	if ((ist = vofi_get_plic_room(pl,np)) != 0)
+	  break;
+	pl->icut[pl->ncut] = m;
+	for (n=0;n<=NDIM;n++)
+	  pl->pln[(NDIM+1)*pl->ncut + n] = pln[n];
+	for (n=0;n<np;n++) {
+	  pl->xpt[NDIM*pl->npt] = xp[n][0];
+	  pl->xpt[NDIM*pl->npt + 1] = xp[n][1];
+	  pl->xpt[NDIM*pl->npt + 2] = xp[n][2];
+	  pl->npt++;
+	}
+	pl->ncut++;
+	pl->ipt[pl->ncut] = pl->npt;
+      }
+  vofi_free_edges(&edg);
+
+  if (ist != 0) {
+    fprintf(stderr,"Out of memory in vofi_Get_plic \n");
+    vofi_Free_plic(pl);
+    return -1.;
+  }
+
+  return vol;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * release the arrays of the PLIC structure                                   *
+ * INPUT: PLIC structure pl                                                   *
+ * OUTPUT: pl: empty PLIC structure                                           *
+ * -------------------------------------------------------------------------- */
+
+void vofi_Free_plic(vofi_plic *pl)
+{
+  free(pl->icut);
+  free(pl->pln);
+  free(pl->ipt);
+  free(pl->xpt);
+  pl->icut = NULL;
+  pl->pln = NULL;
+  pl->ipt = NULL;
+  pl->xpt = NULL;
+  pl->ncut = pl->mcut = 0;
+  pl->npt = pl->mpt = 0;
+
+  return;
+}
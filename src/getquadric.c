@@ -0,0 +1,539 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getquadric.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the implicit function of a quadric and the analytic
+ *        integration of a cell cut by a quadric.
+ */
+
+#include "vofi_stddecl.h"
+#include "vofi_GL.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function of a quadric, f(x) = x.a.x + b.x + c                     *
+ * INPUT: pointer to the coefficients of the quadric, point xy                *
+ * OUTPUT: f: function value                                                  *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_quadric(void *userdata,vofi_creal xy[])
+{
+  const vofi_quadric *q = (const vofi_quadric *) userdata;
+  int i;
+  vofi_real f;
+
+  f = q->c;
+  for (i=0;i<NDIM;i++)
+    f += (q->a[i][0]*xy[0] + q->a[i][1]*xy[1] + q->a[i][2]*xy[2] + q->b[i])*xy[i];
+
+  return f;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * real roots of a*x^2 + b*x + c = 0 with the stable formula, when a is small *
+ * the second root tends to that of the linear equation                       *
+ * INPUT: coefficients a, b and c                                             *
+ * OUTPUT: nr: number of roots (0, 1, 2); array r: roots in increasing order  *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_quadric_roots(vofi_creal a,vofi_creal b,vofi_creal c,vofi_real r[])
+{
+  vofi_real d,q,tmp;
+
+  if (a == 0.) {
+    if (b == 0.)
+      return 0;
+    r[0] = -c/b;
+    return 1;
+  }
+  d = b*b - 4.*a*c;
+  if (d < 0.)
+    return 0;
+  q = (b < 0.) ? -0.5*(b - sqrt(d)) : -0.5*(b + sqrt(d));
+  if (q == 0.) {                                          /* b = c = 0 */
+    r[0] = 0.;
+    return 1;
+  }
+  r[0] = q/a;
+  r[1] = c/q;
+  if (r[0] > r[1]) {
+    tmp = r[0];
+    r[0] = r[1];
+    r[1] = tmp;
+  }
+
+  return 2;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * zeroes of a*x^2 + b*x + c = 0 that are singular points of the heights (or  *
+ * of the areas): the complex ones are kept in the list of the zeroes, the    *
+ * real ones are returned to the caller, which keeps only those of interest   *
+ * INPUT: coefficients a, b and c, list of the zeroes pqd                     *
+ * OUTPUT: nr: number of real zeroes; array r: real zeroes; pqd: updated      *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_quadric_zeroes(vofi_creal a,vofi_creal b,vofi_creal c,vofi_real r[],qdr_data *pqd)
+{
+  vofi_real d;
+
+  d = b*b - 4.*a*c;
+  if (a != 0. && d < 0.) {                             /* complex zeroes */
+    pqd->zr[pqd->nz] = -0.5*b/a;
+    pqd->zi[pqd->nz] = 0.5*sqrt(-d)/fabs(a);
+    pqd->nz++;
+    return 0;
+  }
+
+  return vofi_get_quadric_roots(a,b,c,r);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add a real zero to the list of the zeroes; if the singular point is        *
+ * inside the cell (iin = 1) and inside (0,1), it is also a limit of          *
+ * integration with a square root singularity                                 *
+ * INPUT: real zero z, switch iin, array lim_intg with nlim limits, list of   *
+ * the zeroes pqd                                                             *
+ * OUTPUT: nlim: updated number of limits; array lim_intg and pqd: updated    *
+ * -------------------------------------------------------------------------- */
+
+int vofi_add_quadric_singular(vofi_creal z,vofi_cint iin,vofi_real lim_intg[],int nlim,
+                              qdr_data *pqd)
+{
+  pqd->zr[pqd->nz] = z;
+  pqd->zi[pqd->nz] = 0.;
+  pqd->nz++;
+  if (iin && z > 0. && z < 1.) {
+    lim_intg[nlim++] = z;
+    pqd->zs[pqd->ns++] = z;
+  }
+
+  return nlim;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add the roots of a*x^2 + b*x + c = 0 inside (0,1) to the limits of         *
+ * integration, where the heights (or the areas) have a kink but are smooth   *
+ * on each side                                                               *
+ * INPUT: coefficients a, b and c, array lim_intg with nlim limits            *
+ * OUTPUT: nlim: updated number of limits; array lim_intg: updated            *
+ * -------------------------------------------------------------------------- */
+
+int vofi_add_quadric_limits(vofi_creal a,vofi_creal b,vofi_creal c,vofi_real lim_intg[],
+                            int nlim)
+{
+  int i,nr;
+  vofi_real r[NEND];
+
+  nr = vofi_get_quadric_roots(a,b,c,r);
+  for (i=0;i<nr;i++)
+    if (r[i] > 0. && r[i] < 1.)
+      lim_intg[nlim++] = r[i];
+
+  return nlim;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add the coordinates t where the curve F(u,t) = A u^2 + 2B u t + C t^2 +    *
+ * D u + E t + G = 0 of a face along t is tangent to the line t = const,      *
+ * with the tangency point inside the face, to the singular points            *
+ * INPUT: coefficients cf = {A,B,C,D,E,G}, array lim_intg with nlim limits,   *
+ * list of the zeroes pqd                                                     *
+ * OUTPUT: nlim: updated number of limits; array lim_intg and pqd: updated    *
+ * -------------------------------------------------------------------------- */
+
+int vofi_add_quadric_tangents(vofi_creal cf[],vofi_real lim_intg[],int nlim,qdr_data *pqd)
+{
+  int i,nr;
+  vofi_real r[NEND],u;
+
+  if (cf[0] == 0.)                             /* straight lines: no tangency */
+    return nlim;
+  nr = vofi_get_quadric_zeroes(4.*(cf[0]*cf[2] - cf[1]*cf[1]),4.*(cf[0]*cf[4] - cf[1]*cf[3]),
+                               4.*cf[0]*cf[5] - cf[3]*cf[3],r,pqd);
+  for (i=0;i<nr;i++) {
+    u = -(2.*cf[1]*r[i] + cf[3])/(2.*cf[0]);
+    nlim = vofi_add_quadric_singular(r[i],u > -EPS_M && u < 1. + EPS_M,lim_intg,nlim,pqd);
+  }
+
+  return nlim;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * nodes and weights of the Gauss-Legendre quadrature in a smooth             *
+ * subdivision: the number of points is given by the ellipse with foci at     *
+ * the two ends of the subdivision through the nearest singular point, for a  *
+ * quadrature error of the order of the round-off (a real zero inside the     *
+ * subdivision is not a singular point, else it would be a limit); if more    *
+ * than 20 points are needed the subdivision must be halved; with a singular  *
+ * point at one end, the change of variable x = l0 + (l1-l0)*u^2*(3-2u)       *
+ * removes the square root singularity and all the 20 points are used         *
+ * INPUT: start/end of the subdivision l0 and l1, list of the zeroes pqd      *
+ * OUTPUT: npt: number of points (0: halve the subdivision); arrays xs and    *
+ * ws: nodes and weights                                                      *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_quadric_nodes(vofi_creal l0,vofi_creal l1,const qdr_data *pqd,vofi_real xs[],
+                           vofi_real ws[])
+{
+  int i,k,npt,isqr;
+  vofi_real cs,hs,xr,xi,ae,rho,u;
+  vofi_creal *ptx, *ptw;
+
+  cs = 0.5*(l0 + l1);
+  hs = 0.5*(l1 - l0);
+  isqr = 0;
+  for (i=0;i<pqd->ns;i++)
+    if (fabs(fabs(pqd->zs[i] - cs) - hs) < EPS_R)
+      isqr = 1;
+
+  rho = 1.e+10;
+  for (i=0;i<pqd->nz;i++) {
+    if (pqd->zi[i] == 0. && fabs(pqd->zr[i] - cs) < hs + EPS_R)
+      continue;
+    xr = (pqd->zr[i] - cs)/hs;
+    xi = pqd->zi[i]/hs;
+    ae = 0.5*(sqrt(Sq(xr-1.) + xi*xi) + sqrt(Sq(xr+1.) + xi*xi));
+    rho = MIN(rho,ae + sqrt(MAX(ae*ae-1.,0.)));
+  }
+  npt = (int) (NQERR/log(MAX(rho,1.+EPS_R))) + 1;
+  if (npt > NQGL && hs > EPS_M)                 /* singular point too close */
+    return 0;
+  if (isqr)
+    npt = NQGL;
+
+  if (npt <= 4) {
+    npt = 4;
+    ptx = csi04;
+    ptw = wgt04;
+  }
+  else if (npt <= 8) {
+    npt = 8;
+    ptx = csi08;
+    ptw = wgt08;
+  }
+  else if (npt <= 12) {
+    npt = 12;
+    ptx = csi12;
+    ptw = wgt12;
+  }
+  else if (npt <= 16) {
+    npt = 16;
+    ptx = csi16;
+    ptw = wgt16;
+  }
+  else {
+    npt = 20;
+    ptx = csi20;
+    ptw = wgt20;
+  }
+
+  for (k=0;k<npt;k++) {
+    if (isqr) {
+      u = 0.5*(1. + ptx[k]);
+      xs[k] = l0 + 2.*hs*u*u*(3. - 2.*u);
+      ws[k] = 6.*ptw[k]*hs*u*(1. - u);
+    }
+    else {
+      xs[k] = cs + hs*ptx[k];
+      ws[k] = hs*ptw[k];
+    }
+  }
+
+  return npt;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * length of the segment 0 <= p <= 1 where a*p^2 + b*p + c < 0                *
+ * INPUT: coefficients a, b and c                                             *
+ * OUTPUT: ht: normalized length                                              *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_quadric_length(vofi_creal a,vofi_creal b,vofi_creal c)
+{
+  int nr;
+  vofi_real r[NEND],ht;
+
+  nr = vofi_get_quadric_roots(a,b,c,r);
+  if (a == 0.) {                                          /* linear function */
+    if (nr == 0)
+      return (c < 0.) ? 1. : 0.;
+    ht = MIN(MAX(r[0],0.),1.);
+    return (b > 0.) ? ht : 1. - ht;
+  }
+  if (nr < 2)                                 /* no sign change in the line */
+    return (a < 0.) ? 1. : 0.;
+  ht = MIN(MAX(r[1],0.),1.) - MIN(MAX(r[0],0.),1.);
+
+  return (a > 0.) ? ht : 1. - ht;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * normalized area of the unit square where the conic                         *
+ * P(p,s) = a p^2 + 2e p s + f s^2 + u p + v s + w is negative: the heights   *
+ * along p are exact, they have a kink at the zeroes of P(0,s) and P(1,s)     *
+ * and a square root singularity at the zeroes of the discriminant, where     *
+ * the two intersections merge inside the square; in each smooth              *
+ * subdivision the heights are either constant or integrated with a single    *
+ * Gauss-Legendre quadrature                                                  *
+ * INPUT: coefficients cf = {a,e,f,u,v,w}                                     *
+ * OUTPUT: area: normalized area; array nl: number of empty, full and cut     *
+ * lines, updated                                                             *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_quadric_area(vofi_creal cf[],int nl[])
+{
+  int i,k,ns,nr,nsub,npt,nstk;
+  vofi_real lim_intg[NQSEG],xs[NQGL],ws[NQGL],r[NEND],stk[NQSTK];
+  vofi_real area,ht,pd,l0;
+  qdr_data qd;
+
+  qd.nz = qd.ns = 0;
+  lim_intg[0] = 0.;
+  nsub = 1;
+  nsub = vofi_add_quadric_limits(cf[2],cf[4],cf[5],lim_intg,nsub);
+  nsub = vofi_add_quadric_limits(cf[2],2.*cf[1] + cf[4],cf[0] + cf[3] + cf[5],lim_intg,nsub);
+  if (cf[0] != 0.) {
+    nr = vofi_get_quadric_zeroes(4.*(cf[1]*cf[1] - cf[0]*cf[2]),4.*(cf[1]*cf[3] - cf[0]*cf[4]),
+                                 cf[3]*cf[3] - 4.*cf[0]*cf[5],r,&qd);
+    for (i=0;i<nr;i++) {
+      pd = -(2.*cf[1]*r[i] + cf[3])/(2.*cf[0]);
+      nsub = vofi_add_quadric_singular(r[i],pd > -EPS_M && pd < 1. + EPS_M,lim_intg,nsub,&qd);
+    }
+  }
+  else if (cf[1] != 0.) {                /* linear function: pole of the height */
+    qd.zr[qd.nz] = -0.5*cf[3]/cf[1];
+    qd.zi[qd.nz] = 0.;
+    qd.nz++;
+  }
+  lim_intg[nsub] = 1.;
+  nsub = vofi_sort_limits(lim_intg,1.,nsub);
+
+  area = 0.;
+  for (ns=1;ns<=nsub;ns++) {
+    xs[0] = 0.5*(lim_intg[ns-1] + lim_intg[ns]);
+    ht = vofi_get_quadric_length(cf[0],2.*cf[1]*xs[0] + cf[3],(cf[2]*xs[0] + cf[4])*xs[0] + cf[5]);
+    if (ht == 0. || ht == 1.) {               /* no interface: constant height */
+      nl[(int) ht]++;
+      area += ht*(lim_intg[ns] - lim_intg[ns-1]);
+      continue;
+    }
+    nl[2]++;
+    l0 = lim_intg[ns-1];
+    nstk = 0;
+    stk[nstk++] = lim_intg[ns];
+    while (nstk > 0) {             /* halve the subdivision if necessary */
+      npt = vofi_get_quadric_nodes(l0,stk[nstk-1],&qd,xs,ws);
+      if (npt == 0) {
+	stk[nstk] = 0.5*(l0 + stk[nstk-1]);
+	nstk++;
+	continue;
+      }
+      for (k=0;k<npt;k++) {
+	ht = vofi_get_quadric_length(cf[0],2.*cf[1]*xs[k] + cf[3],
+                                     (cf[2]*xs[k] + cf[4])*xs[k] + cf[5]);
+	area += ws[k]*ht;
+      }
+      l0 = stk[--nstk];
+    }
+  }
+
+  return area;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the volume fraction of a cell with a quadric interface: in 2D      *
+ * with the area of vofi_get_quadric_area; in 3D with a Gauss-Legendre        *
+ * quadrature of the area of the planes along the tertiary direction t, in    *
+ * the subdivisions where this area is smooth, i.e. between the values of t   *
+ * where the quadric crosses an edge along t, is tangent to a face along t    *
+ * or has a critical point in the plane; the tertiary direction is that with  *
+ * the largest minor of the matrix a, a quadric with a matrix of rank one     *
+ * (parabolic cylinder or two parallel planes) is left to the general         *
+ * algorithm                                                                  *
+ * INPUT: pointer to the coefficients of the quadric, starting point x0,      *
+ * grid spacing h0, space dimension ndim0                                     *
+ * OUTPUT: cc: volume fraction value (-1: degenerate quadric), icc:           *
+ * full/empty/cut cell (1/0/-1)                                               *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_cc_quadric(const vofi_quadric *q,vofi_creal x0[],vofi_creal h0,
+                              vofi_cint ndim0,vofi_int_cpt icc)
+{
+  int i,j,k,ip,is,it,ns,nr,nsub,npt,nstk,nl[3],nlt[3];
+  vofi_real sa[NDIM][NDIM],gb[NDIM],lim_intg[NQSEG],xs[NQGL],ws[NQGL],stk[NQSTK];
+  vofi_real cf[6],rp[NEND],rs[NEND],r[NEND],minor,amax,det,f0,t,sp,ss,area,l0,cc;
+  qdr_data qd;
+
+  /* quadric in the local coordinates of the cell, 0 <= y_i <= 1 */
+  for (i=0;i<NDIM;i++) {
+    gb[i] = q->b[i];
+    for (j=0;j<NDIM;j++) {
+      sa[i][j] = 0.5*(q->a[i][j] + q->a[j][i]);
+      gb[i] += (q->a[i][j] + q->a[j][i])*x0[j];
+    }
+  }
+  amax = 0.;
+  for (i=0;i<NDIM;i++) {
+    gb[i] *= h0;
+    for (j=0;j<NDIM;j++) {
+      sa[i][j] *= h0*h0;
+      amax = MAX(amax,fabs(sa[i][j]));
+    }
+  }
+  f0 = vofi_Get_quadric((void *) q,x0);
+  nl[0] = nl[1] = nl[2] = 0;
+
+  if (ndim0 == 2) {
+    cf[0] = sa[0][0];
+    cf[1] = sa[0][1];
+    cf[2] = sa[1][1];
+    cf[3] = gb[0];
+    cf[4] = gb[1];
+    cf[5] = f0;
+    cc = vofi_get_quadric_area(cf,nl);
+  }
+  else {
+    minor = -1.;                   /* tertiary direction: the largest minor */
+    ip = 0;
+    is = 1;
+    it = 2;
+    for (k=0;k<NDIM;k++) {
+      i = (k+1)%NDIM;
+      j = (k+2)%NDIM;
+      det = fabs(sa[i][i]*sa[j][j] - sa[i][j]*sa[i][j]);
+      if (det > minor) {
+	minor = det;
+	ip = MIN(i,j);
+	is = MAX(i,j);
+	it = k;
+      }
+    }
+    if (amax > 0. && minor <= EPS_R*amax*amax)                 /* rank one */
+      return -1.;
+    det = sa[ip][ip]*sa[is][is] - sa[ip][is]*sa[ip][is];
+
+    qd.nz = qd.ns = 0;
+    lim_intg[0] = 0.;
+    nsub = 1;
+    for (j=0;j<2;j++)                                  /* four edges along t */
+      for (i=0;i<2;i++)
+	nsub = vofi_add_quadric_limits(sa[it][it],gb[it] + 2.*(i*sa[ip][it] + j*sa[is][it]),
+                                       f0 + i*(gb[ip] + i*sa[ip][ip]) +
+                                       j*(gb[is] + j*sa[is][is]) + 2.*i*j*sa[ip][is],
+                                       lim_intg,nsub);
+    for (i=0;i<2;i++) {                                /* four faces along t */
+      cf[0] = sa[is][is];
+      cf[1] = sa[is][it];
+      cf[2] = sa[it][it];
+      cf[3] = gb[is] + 2.*i*sa[ip][is];
+      cf[4] = gb[it] + 2.*i*sa[ip][it];
+      cf[5] = f0 + i*(gb[ip] + i*sa[ip][ip]);
+      nsub = vofi_add_quadric_tangents(cf,lim_intg,nsub,&qd);
+      cf[0] = sa[ip][ip];
+      cf[1] = sa[ip][it];
+      cf[3] = gb[ip] + 2.*i*sa[ip][is];
+      cf[4] = gb[it] + 2.*i*sa[is][it];
+      cf[5] = f0 + i*(gb[is] + i*sa[is][is]);
+      nsub = vofi_add_quadric_tangents(cf,lim_intg,nsub,&qd);
+    }
+    if (det != 0.) {             /* critical point of the conic in the plane */
+      rp[0] = gb[ip];
+      rp[1] = 2.*sa[ip][it];
+      rs[0] = gb[is];
+      rs[1] = 2.*sa[is][it];
+      nr = vofi_get_quadric_zeroes(4.*det*sa[it][it] - (sa[is][is]*rp[1]*rp[1] -
+                                   2.*sa[ip][is]*rp[1]*rs[1] + sa[ip][ip]*rs[1]*rs[1]),
+                                   4.*det*gb[it] - 2.*(sa[is][is]*rp[0]*rp[1] -
+                                   sa[ip][is]*(rp[0]*rs[1] + rp[1]*rs[0]) +
+                                   sa[ip][ip]*rs[0]*rs[1]),
+                                   4.*det*f0 - (sa[is][is]*rp[0]*rp[0] -
+                                   2.*sa[ip][is]*rp[0]*rs[0] + sa[ip][ip]*rs[0]*rs[0]),r,&qd);
+      for (i=0;i<nr;i++) {
+	t = r[i];
+	sp = -(sa[is][is]*(rp[0] + rp[1]*t) - sa[ip][is]*(rs[0] + rs[1]*t))/(2.*det);
+	ss = -(sa[ip][ip]*(rs[0] + rs[1]*t) - sa[ip][is]*(rp[0] + rp[1]*t))/(2.*det);
+	nsub = vofi_add_quadric_singular(t,sp > -EPS_M && sp < 1. + EPS_M && ss > -EPS_M &&
+                                         ss < 1. + EPS_M,lim_intg,nsub,&qd);
+      }
+    }
+    lim_intg[nsub] = 1.;
+    nsub = vofi_sort_limits(lim_intg,1.,nsub);
+
+    cc = 0.;
+    cf[0] = sa[ip][ip];
+    cf[1] = sa[ip][is];
+    cf[2] = sa[is][is];
+    for (ns=1;ns<=nsub;ns++) {      /* loop over the smooth subdivisions in t */
+      t = 0.5*(lim_intg[ns-1] + lim_intg[ns]);
+      cf[3] = gb[ip] + 2.*sa[ip][it]*t;
+      cf[4] = gb[is] + 2.*sa[is][it]*t;
+      cf[5] = f0 + (gb[it] + sa[it][it]*t)*t;
+      nlt[0] = nlt[1] = nlt[2] = 0;
+      area = vofi_get_quadric_area(cf,nlt);
+      if (nlt[2] == 0 && nlt[0]*nlt[1] == 0) {   /* no interface: constant area */
+	nl[0] += nlt[0];
+	nl[1] += nlt[1];
+	cc += area*(lim_intg[ns] - lim_intg[ns-1]);
+	continue;
+      }
+      nl[2]++;
+      l0 = lim_intg[ns-1];
+      nstk = 0;
+      stk[nstk++] = lim_intg[ns];
+      while (nstk > 0) {           /* halve the subdivision if necessary */
+	npt = vofi_get_quadric_nodes(l0,stk[nstk-1],&qd,xs,ws);
+	if (npt == 0) {
+	  stk[nstk] = 0.5*(l0 + stk[nstk-1]);
+	  nstk++;
+	  continue;
+	}
+	for (k=0;k<npt;k++) {
+	  t = xs[k];
+	  cf[3] = gb[ip] + 2.*sa[ip][it]*t;
+	  cf[4] = gb[is] + 2.*sa[is][it]*t;
+	  cf[5] = f0 + (gb[it] + sa[it][it]*t)*t;
+	  cc += ws[k]*vofi_get_quadric_area(cf,nlt);
+	}
+	l0 = stk[--nstk];
+      }
+    }
+  }
+
+  if (nl[2] > 0 || (nl[0] > 0 && nl[1] > 0))
+    *icc = -1;
+  else {
+    *icc = (nl[1] > 0) ? 1 : 0;
+    cc = (vofi_real) *icc;
+  }
+
+  return MIN(MAX(cc,0.),1.);
+}
@@ -0,0 +1,90 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getrefine.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the driver that computes the volume fraction of the
+ *        sub-cells of a uniform refinement of a cell, that sum to the
+ *        volume fraction of the cell.
+ */
+
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction of the nref^2 (nref^3) sub-cells of  *
+ * a cell, e.g. for the prolongation of multigrid and AMR methods: the        *
+ * sub-cells are a grid of spacing h0/nref, swept with the hierarchical       *
+ * classification of vofi_Get_cc_grid and its edge cache, hence the limits    *
+ * along the sides shared by the sub-cells are computed once; the             *
+ * difference between the volume fraction of the cell and the mean value of   *
+ * the sub-cells, of the order of the integration error, is distributed to    *
+ * the cut sub-cells with the weight c(1 - c), so that the sub-cells sum to   *
+ * the cell; if this would move a sub-cell out of [0,1] (a structure below    *
+ * the resolution of the cell) the sub-cells are kept and their mean value is *
+ * returned                                                                   *
+ * INPUT: pointer to the implicit function, minor vertex x0, grid spacing h0, *
+ * characteristic function value fh, space dimension ndim0, number of         *
+ * sub-cells along each direction nref                                        *
+ * OUTPUT: ccs: volume fraction values of the sub-cells,                      *
+ * ccs[i + nref*(j + nref*k)], cc: volume fraction value of the cell, the     *
+ * mean value of the sub-cells                                                *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_refine(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                             vofi_creal fh,vofi_cint ndim0,vofi_cint nref,vofi_real ccs[])
+{
+  int n,nr,icc,nc[NDIM];
+  long int m,ns;
+  vofi_real cc,sum,wsum,dv,cn;
+  vofi_grid sub;
+
+  nr = MAX(nref,1);
+  ns = 1;
+  for (n=0;n<ndim0;n++) {
+    nc[n] = nr;
+    ns *= nr;
+  }
+  vofi_Set_grid(&sub,x0,h0/nr,nc,ndim0);
+  sub.nblk = nr;                         /* the cell is the first block */
+  sub.nthr = 1;
+  vofi_Get_cc_grid(impl_func,userdata,&sub,fh/nr,ccs);
+  cc = vofi_get_cc_cell(impl_func,userdata,x0,h0,fh,ndim0,NULL,NULL,&icc);
+
+  sum = wsum = 0.;
+  for (m=0;m<ns;m++) {
+    sum += ccs[m];
+    wsum += ccs[m]*(1. - ccs[m]);
+  }
+  dv = ns*cc - sum;
+  icc = (wsum > EPS_NOT0);
+  for (m=0;m<ns && icc;m++) {           /* the sub-cells stay in [0,1] */
+    cn = ccs[m] + dv*ccs[m]*(1. - ccs[m])/wsum;
+    if (cn < 0. || cn > 1.)
+      icc = 0;
+  }
+  if (!icc)
+    return sum/ns;
+  for (m=0;m<ns;m++)
+    ccs[m] += dv*ccs[m]*(1. - ccs[m])/wsum;
+
+  return cc;
+}
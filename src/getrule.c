@@ -0,0 +1,323 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getrule.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the drivers that return the quadrature rules of the
+ *        reference phase and of the interface in a cell, or the integral of
+ *        a weight function over the reference phase.
+ */
+
+#include "vofi_stddecl.h"
+#include "vofi_GL.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the volume fraction value in a given cell, together with the       *
+ * quadrature rules of the reference phase and of the interface: in a cut     *
+ * rectangle the nodes of each height where f < 0 are the rule->npr          *
+ * Gauss-Legendre nodes along the primary direction, with the weights of the  *
+ * internal (and external) integration, and its end point on the interface   *
+ * is a node of the interface rule; full rectangles, hexahedra and subcells   *
+ * have a tensor product rule                                                 *
+ * INPUT:  pointer to the implicit function, starting point x0, grid          *
+ * spacing h0, characteristic function value fh, space dimension ndim0,       *
+ * arrays and their sizes in the rule structure                               *
+ * OUTPUT: cc: volume fraction value, rule: nodes and weights                 *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_rule(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                           vofi_creal fh,vofi_cint ndim0,vofi_rule *rule)
+{
+  int icc;
+  rul_data rul;
+
+  rule->npr = vofi_init_rule(&rul,rule,rule->npr,ndim0);
+
+  return vofi_get_cc_sub(impl_func,userdata,x0,h0,fh,ndim0,NULL,0,NULL,&rul,&icc);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the volume fraction value in a given cell, together with the       *
+ * integral of a weight function over the reference phase, in the same pass  *
+ * and with the nodes of the volume rule of vofi_Get_cc_rule, without storing *
+ * them                                                                       *
+ * INPUT:  pointer to the implicit function, starting point x0, grid          *
+ * spacing h0, characteristic function value fh, space dimension ndim0,       *
+ * pointer to the weight function wfunc and its data wdata, number of nodes   *
+ * npr along the heights and the sides of the full regions                    *
+ * OUTPUT: cc: volume fraction value, wint: integral of the weight function   *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_weight(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                             vofi_creal fh,vofi_cint ndim0,integrand wfunc,void *wdata,
+                             vofi_cint npr,vofi_real *wint)
+{
+  int icc;
+  vofi_real cc;
+  rul_data rul;
+
+  vofi_init_rule(&rul,NULL,npr,ndim0);
+  rul.wfunc = wfunc;
+  rul.wdata = wdata;
+  cc = vofi_get_cc_sub(impl_func,userdata,x0,h0,fh,ndim0,NULL,0,NULL,&rul,&icc);
+  *wint = rul.wint;
+
+  return cc;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * compute the volume fraction value of a two-dimensional cell of an         *
+ * axisymmetric (r-z) grid, the ratio of the integral of the radius r over    *
+ * the reference phase to that over the cell, h0^2*(r0 + h0/2), with the      *
+ * radius of the minor vertex r0: the radial weight is accumulated in the     *
+ * same pass of vofi_get_area, in closed form along the heights of each       *
+ * column, without any evaluation of the implicit function besides those of  *
+ * the area                                                                   *
+ * INPUT:  pointer to the implicit function, starting point x0, grid          *
+ * spacing h0, characteristic function value fh, radial direction irad        *
+ * (0/1: r = x/y), the radius must be nonnegative                             *
+ * OUTPUT: cc: axisymmetric volume fraction value                             *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_axi(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal h0,
+                          vofi_creal fh,vofi_cint irad)
+{
+  int icc;
+  vofi_real cc;
+  rul_data rul;
+
+  vofi_init_rule(&rul,NULL,NPAXI,2);
+  rul.irad = (irad == 1) ? 1 : 0;
+  cc = vofi_get_cc_sub(impl_func,userdata,x0,h0,fh,2,NULL,0,NULL,&rul,&icc);
+  if (icc >= 0)
+    return cc;
+
+  return rul.wint/(h0*h0*(x0[rul.irad] + 0.5*h0));
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * initialize the quadrature rules of a cell with npr Gauss-Legendre nodes    *
+ * INPUT: arrays of the caller rule (may be NULL), number of nodes npr,      *
+ * space dimension ndim0                                                      *
+ * OUTPUT: prl: quadrature rules of the cell, with no nodes and no weight    *
+ * function; npr: number of nodes (20 if not a tabulated value)              *
+ * -------------------------------------------------------------------------- */
+
+int vofi_init_rule(rul_data *prl,vofi_rule *rule,vofi_cint npr,vofi_cint ndim0)
+{
+  switch (npr) {
+  case 4:
+    prl->xpr = csi04;
+    prl->wpr = wgt04;
+    break;
+  case 8:
+    prl->xpr = csi08;
+    prl->wpr = wgt08;
+    break;
+  case 12:
+    prl->xpr = csi12;
+    prl->wpr = wgt12;
+    break;
+  case 16:
+    prl->xpr = csi16;
+    prl->wpr = wgt16;
+    break;
+  default:
+    prl->xpr = csi20;
+    prl->wpr = wgt20;
+    break;
+  }
+  prl->npr = (npr == 4 || npr == 8 || npr == 12 || npr == 16) ? npr : 20;
+  prl->rule = rule;
+  prl->ndim = ndim0;
+  prl->wext = 1.;
+  prl->wfunc = NULL;
+  prl->wdata = NULL;
+  prl->wint = 0.;
+  prl->irad = -1;
+  if (rule != NULL)
+    rule->nvol = rule->nsrf = 0;
+
+  return prl->npr;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add the Gauss-Legendre nodes of the segment [p0,p0+hp] of a column along   *
+ * the primary direction to the volume rule, the weight of each node is the   *
+ * product of the weights of the external, internal and column integration;  *
+ * with a weight function its values at the nodes are added to its integral,  *
+ * the radial weight, linear along the column, is integrated exactly          *
+ * INPUT: quadrature rules prl, base point of the column xb, primary          *
+ * direction pdir, start p0 and length hp of the segment, weight ws of the    *
+ * internal integration                                                       *
+ * OUTPUT: prl->rule: nodes and weights of the volume rule, prl->wint:        *
+ * integral of the weight function                                            *
+ * -------------------------------------------------------------------------- */
+
+void vofi_add_rule_column(rul_data *prl,vofi_creal xb[],vofi_creal pdir[],vofi_creal p0,
+                          vofi_creal hp,vofi_creal ws)
+{
+  int i,m,n;
+  vofi_rule *rule = prl->rule;
+  vofi_real x1[NDIM];
+  vofi_real xp,wp;
+
+  if (prl->irad >= 0)                       /* axisymmetric weight r*dp */
+    prl->wint += prl->wext*ws*hp*(xb[prl->irad] + pdir[prl->irad]*(p0 + 0.5*hp));
+  if (prl->wfunc == NULL && rule == NULL)
+    return;
+
+  for (m=0;m<prl->npr;m++) {
+    xp = p0 + 0.5*hp*(1. + prl->xpr[m]);
+    for (i=0;i<NDIM;i++)
+      x1[i] = xb[i] + pdir[i]*xp;
+    wp = prl->wext*ws*0.5*hp*prl->wpr[m];
+    if (prl->wfunc != NULL)
+      prl->wint += wp*prl->wfunc(prl->wdata,x1);
+    if (rule != NULL) {
+      n = rule->nvol;
+      if (n < rule->mvol) {
+	for (i=0;i<NDIM;i++)
+	  rule->xvol[NDIM*n+i] = x1[i];
+	rule->wvol[n] = wp;
+      }
+      rule->nvol++;
+    }
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add the nodes of a full rectangle [s0,s1]x[0,h0] along the secondary and   *
+ * primary directions to the volume rule, with a tensor product rule          *
+ * INPUT: quadrature rules prl, base point xb, primary and secondary          *
+ * directions pdir and sdir, limits s0 and s1 along sdir, side h0 along pdir  *
+ * OUTPUT: prl->rule: nodes and weights of the volume rule                    *
+ * -------------------------------------------------------------------------- */
+
+void vofi_add_rule_rect(rul_data *prl,vofi_creal xb[],vofi_creal pdir[],vofi_creal sdir[],
+                        vofi_creal s0,vofi_creal s1,vofi_creal h0)
+{
+  int i,k;
+  vofi_real x1[NDIM];
+  vofi_real ds,xs;
+
+  ds = s1 - s0;
+  for (k=0;k<prl->npr;k++) {
+    xs = s0 + 0.5*ds*(1. + prl->xpr[k]);
+    for (i=0;i<NDIM;i++)
+      x1[i] = xb[i] + sdir[i]*xs;
+    vofi_add_rule_column(prl,x1,pdir,0.,h0,0.5*ds*prl->wpr[k]);
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add the nodes of a full square/cube to the volume rule, with a tensor      *
+ * product rule along the coordinate directions                               *
+ * INPUT: quadrature rules prl, starting point x0, grid spacing h0, space     *
+ * dimension ndim0                                                            *
+ * OUTPUT: prl->rule: nodes and weights of the volume rule                    *
+ * -------------------------------------------------------------------------- */
+
+void vofi_add_rule_box(rul_data *prl,vofi_creal x0[],vofi_creal h0,vofi_cint ndim0)
+{
+  int i,k;
+  vofi_creal xdir[NDIM] = {1.,0.,0.};
+  vofi_creal ydir[NDIM] = {0.,1.,0.};
+  vofi_real x1[NDIM];
+
+  if (ndim0 == 2) {
+    prl->wext = 1.;
+    vofi_add_rule_rect(prl,x0,xdir,ydir,0.,h0,h0);
+  }
+  else
+    for (k=0;k<prl->npr;k++) {
+      for (i=0;i<NDIM;i++)
+	x1[i] = x0[i];
+      x1[2] += 0.5*h0*(1. + prl->xpr[k]);
+      prl->wext = 0.5*h0*prl->wpr[k];
+      vofi_add_rule_rect(prl,x1,xdir,ydir,0.,h0,h0);
+    }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * add an interface point to the interface rule, the unit normal is computed  *
+ * with centred differences, the weight is that of the column times the       *
+ * ratio |grad f|/|df/dp|, that is the length (area) element of the interface *
+ * over the internal (and external) integration element                       *
+ * INPUT: pointer to the implicit function, quadrature rules prl, interface   *
+ * point xs, primary direction pdir, grid spacing h0, weight ws of the        *
+ * internal integration                                                       *
+ * OUTPUT: prl->rule: nodes, weights and normals of the interface rule        *
+ * -------------------------------------------------------------------------- */
+
+void vofi_add_rule_point(integrand impl_func,void *userdata,rul_data *prl,vofi_creal xs[],
+                         vofi_creal pdir[],vofi_creal h0,vofi_creal ws)
+{
+  int i,n;
+  vofi_creal dh = 1.e-5*h0;                     /* for 1st deriv. with c.f.d. */
+  vofi_rule *rule = prl->rule;
+  vofi_real xp[NDIM],xm[NDIM],gf[NDIM];
+  vofi_real gn,gp;
+
+  if (rule == NULL)                                  /* no interface rule */
+    return;
+
+  n = rule->nsrf;
+  if (n < rule->msrf) {
+    gn = gp = 0.;
+    for (i=0;i<NDIM;i++) {
+      xp[i] = xm[i] = xs[i];
+      gf[i] = 0.;
+    }
+    for (i=0;i<prl->ndim;i++) {
+      xp[i] += dh;
+      xm[i] -= dh;
+      gf[i] = 0.5*(impl_func(userdata,xp) - impl_func(userdata,xm))/dh;
+      xp[i] = xm[i] = xs[i];
+      gn += gf[i]*gf[i];
+      gp += gf[i]*pdir[i];
+    }
+    gn = MAX(sqrt(gn),EPS_NOT0);
+    gp = MAX(fabs(gp),EPS_NOT0);
+    for (i=0;i<NDIM;i++) {
+      rule->xsrf[NDIM*n+i] = xs[i];
+      rule->vsrf[NDIM*n+i] = gf[i]/gn;
+    }
+    rule->wsrf[n] = prl->wext*ws*gn/gp;
+  }
+  rule->nsrf++;
+
+  return;
+}
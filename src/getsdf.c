@@ -0,0 +1,319 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getsdf.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the driver that computes the volume fraction of all
+ *        cells of a grid together with the signed distance from the 
+ *        interface at the cell centres in a narrow band.
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * unit normal of the interface in the point xs with centred differences      *
+ * INPUT: pointer to the implicit function, point xs, grid spacing h0, space  *
+ * dimension ndim0                                                            *
+ * OUTPUT: nv: unit normal, ist: success/failure (1/0, zero gradient)         *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_sdf_normal(integrand impl_func,void *userdata,vofi_creal xs[],vofi_creal h0,
+                        vofi_cint ndim0,vofi_real nv[])
+{
+  int i;
+  vofi_creal dh = 1.e-5*h0;                     /* for 1st deriv. with c.f.d. */
+  vofi_real xp[NDIM],xm[NDIM];
+  vofi_real gn;
+
+  gn = 0.;
+  for (i=0;i<NDIM;i++) {
+    xp[i] = xm[i] = xs[i];
+    nv[i] = 0.;
+  }
+  for (i=0;i<ndim0;i++) {
+    xp[i] += dh;
+    xm[i] -= dh;
+    nv[i] = 0.5*(impl_func(userdata,xp) - impl_func(userdata,xm))/dh;
+    xp[i] = xm[i] = xs[i];
+    gn += nv[i]*nv[i];
+  }
+  gn = sqrt(gn);
+  if (gn < EPS_NOT0)
+    return 0;
+  for (i=0;i<NDIM;i++)
+    nv[i] /= gn;
+
+  return 1;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * zero of the implicit function on the line through xc with direction dir,   *
+ * in the segment from xc towards the side of the interface point xs, with    *
+ * the length of the distance of xs plus half a cell, or of half a cell on    *
+ * the other side of xc: the segment starts in the phase of xc and the zero   *
+ * is bracketed if the interface is crossed once                              *
+ * INPUT: pointer to the implicit function, point xc, unit direction dir,     *
+ * interface point xs, grid spacing h0                                        *
+ * OUTPUT: x1: zero on the line, ist: success/failure (1/0, no sign change)   *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_sdf_line(integrand impl_func,void *userdata,vofi_creal xc[],vofi_creal dir[],
+                      vofi_creal xs[],vofi_creal h0,vofi_real x1[])
+{
+  int i;
+  vofi_cint true_sign=1;
+  vofi_real xp[NDIM],sd[NDIM],fe[NEND];
+  vofi_real dn,s0,sz;
+
+  dn = 0.;
+  for (i=0;i<NDIM;i++)
+    dn += (xs[i] - xc[i])*dir[i];
+  s0 = sqrt(Sqd3(xs,xc)) + 0.5*h0;
+  for (i=0;i<NDIM;i++) {
+    sd[i] = (dn < 0.) ? -dir[i] : dir[i];
+    xp[i] = xc[i] + s0*sd[i];
+  }
+  fe[0] = impl_func(userdata,xc);
+  fe[1] = impl_func(userdata,xp);
+  if (fe[0]*fe[1] >= 0.) {          /* xc close to the interface: other side */
+    s0 = 0.5*h0;
+    for (i=0;i<NDIM;i++) {
+      sd[i] = -sd[i];
+      xp[i] = xc[i] + s0*sd[i];
+    }
+    fe[1] = impl_func(userdata,xp);
+    if (fe[0]*fe[1] >= 0.)
+      return 0;
+  }
+  sz = vofi_get_segment_zero(impl_func,userdata,fe,xc,sd,s0,true_sign);
+  if (sz < 0.)
+    return 0;
+  if (fe[0] > 0.)
+    sz = s0 - sz;
+  for (i=0;i<NDIM;i++)
+    x1[i] = xc[i] + sz*sd[i];
+
+  return 1;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * distance of the point xc from the interface, starting from the interface   *
+ * point xs: the first new point is the zero along the normal in xs through   *
+ * xc, then the centre of curvature is estimated with the closest points of   *
+ * the normal lines in the last two points and the next point is the zero     *
+ * along the line through xc and this centre, or along the normal in the      *
+ * last point if the two normals are almost parallel; the iteration is exact  *
+ * in one step for a plane, in two steps for a circle or a sphere, and it     *
+ * stops when xc - xs is along the normal, the point does not move or there   *
+ * is no sign change; all the points are on the interface, hence the          *
+ * distance is the minimum of their distances                                 *
+ * INPUT: pointer to the implicit function, point xc, interface point xs,     *
+ * grid spacing h0, space dimension ndim0                                     *
+ * OUTPUT: ds: distance of xc from the interface                              *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_sdf_cell(integrand impl_func,void *userdata,vofi_creal xc[],vofi_creal xs[],
+                            vofi_creal h0,vofi_cint ndim0)
+{
+  int i,it;
+  vofi_real y0[NDIM],y1[NDIM],y2[NDIM],n0[NDIM],n1[NDIM],dir[NDIM],w[NDIM];
+  vofi_real ds,dm,b,d,e,den,a0,a1;
+
+  for (i=0;i<NDIM;i++)
+    y0[i] = xs[i];
+  ds = sqrt(Sqd3(xc,y0));
+  if (!vofi_get_sdf_normal(impl_func,userdata,y0,h0,ndim0,n0) ||
+      !vofi_get_sdf_line(impl_func,userdata,xc,n0,y0,h0,y1))
+    return ds;
+  ds = MIN(ds,sqrt(Sqd3(xc,y1)));
+
+  for (it=0;it<NSDF;it++) {
+    if (sqrt(Sqd3(y0,y1)) < EPS_LOC*h0 ||
+	!vofi_get_sdf_normal(impl_func,userdata,y1,h0,ndim0,n1))
+      break;
+    d = 0.;                   /* xc - y1 along the normal: tangential residual */
+    for (i=0;i<NDIM;i++)
+      d += (xc[i] - y1[i])*n1[i];
+    for (i=0;i<NDIM;i++)
+      w[i] = xc[i] - y1[i] - d*n1[i];
+    if (sqrt(Sq3(w)) < EPS_LOC*h0)
+      break;
+    b = d = e = 0.;              /* closest points of y0 + a0 n0, y1 + a1 n1 */
+    for (i=0;i<NDIM;i++) {
+      w[i] = y0[i] - y1[i];
+      b += n0[i]*n1[i];
+      d += n0[i]*w[i];
+      e += n1[i]*w[i];
+    }
+    den = 1. - b*b;
+    dm = 0.;
+    if (den > EPS_LOC) {                     /* line through the centre */
+      a0 = (b*e - d)/den;
+      a1 = (e - b*d)/den;
+      for (i=0;i<NDIM;i++) {
+	dir[i] = xc[i] - 0.5*(y0[i] + a0*n0[i] + y1[i] + a1*n1[i]);
+	dm += dir[i]*dir[i];
+      }
+      dm = sqrt(dm);
+    }
+    if (dm < EPS_LOC*h0) {  /* almost parallel normals: normal line in y1 */
+      dm = 1.;
+      for (i=0;i<NDIM;i++)
+	dir[i] = n1[i];
+    }
+    for (i=0;i<NDIM;i++)
+      dir[i] /= dm;
+    if (!vofi_get_sdf_line(impl_func,userdata,xc,dir,y1,h0,y2))
+      break;
+    ds = MIN(ds,sqrt(Sqd3(xc,y2)));
+    for (i=0;i<NDIM;i++) {
+      y0[i] = y1[i];
+      y1[i] = y2[i];
+      n0[i] = n1[i];
+    }
+  }
+
+  return ds;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction in all cells of a grid, as           *
+ * vofi_Get_cc_grid, and the signed distance from the interface at the cell   *
+ * centres in a narrow band, negative in the reference phase: the band are    *
+ * the cells within nband cells along each direction of a cut cell, the       *
+ * interface points of the cut cells, from the edge cache of the grid sweep   *
+ * with vofi_Get_plic, give the closest point of the cell centre among them   *
+ * in the nearby cut cells, that is then refined with vofi_get_sdf_cell; the  *
+ * other cells get the distance dmax = (nband+1)*sqrt(ndim)*h0, larger than   *
+ * that of any cell of the band                                               *
+ * INPUT: pointer to the implicit function, grid structure, characteristic    *
+ * function value fh, width of the band nband                                 *
+ * OUTPUT: cc: volume fraction values, sd: signed distance values (same       *
+ * layout), vol: total volume of the reference phase (-1 if out of memory)    *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_sdf(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                          vofi_cint nband,vofi_real cc[],vofi_real sd[])
+{
+  int i,j,k,n,nb,iv[NDIM],jv[NDIM],lo[NDIM],hi[NDIM],nc[NDIM];
+  long int m,mn,c,p,ntot,*icm;
+  vofi_creal h0 = grid->h0;
+  vofi_real vol,dmax,d2,d2min,fc,xc[NDIM],xs[NDIM];
+  vofi_plic pl;
+#ifdef _OPENMP
+  int nthr;
+#endif
+
+  nb = MAX(nband,0);
+  ntot = 1;
+  for (n=0;n<NDIM;n++) {
+    nc[n] = (n < grid->ndim) ? grid->nc[n] : 1;
+    ntot *= nc[n];
+  }
+  dmax = (nb+1)*sqrt((vofi_real) grid->ndim)*h0;
+
+  vol = vofi_Get_plic(impl_func,userdata,grid,fh,cc,&pl);
+  icm = (vol < 0.) ? NULL : (long int *) malloc(ntot*sizeof(long int));
+  if (icm == NULL) {
+    fprintf(stderr,"Out of memory in vofi_Get_cc_sdf \n");
+    vofi_Free_plic(&pl);
+    return -1.;
+  }
+
+  /* icm: index of the cut cell, -2 in the band, -1 outside */
+  for (m=0;m<ntot;m++) {
+    icm[m] = -1;
+    sd[m] = (cc[m] > 0.5) ? -dmax : dmax;
+  }
+  for (c=0;c<pl.ncut;c++)
+    icm[pl.icut[c]] = c;
+  for (c=0;c<pl.ncut;c++) {
+    m = pl.icut[c];
+    iv[0] = (int) (m % nc[0]);
+    iv[1] = (int) ((m / nc[0]) % nc[1]);
+    iv[2] = (int) (m / ((long int) nc[0]*nc[1]));
+    for (n=0;n<NDIM;n++) {
+      lo[n] = MAX(iv[n]-nb,0);
+      hi[n] = MIN(iv[n]+nb,nc[n]-1);
+    }
+    for (k=lo[2];k<=hi[2];k++)
+      for (j=lo[1];j<=hi[1];j++)
+	for (i=lo[0];i<=hi[0];i++) {
+	  mn = i + nc[0]*(j + (long int) nc[1]*k);
+	  if (icm[mn] == -1)
+	    icm[mn] = -2;
+	}
+  }
+
+#ifdef _OPENMP
+  nthr = (grid->nthr > 0) ? grid->nthr : omp_get_max_threads();
+#pragma omp parallel for schedule(dynamic,64) num_threads(nthr) \
+  private(i,j,k,n,iv,jv,lo,hi,mn,c,p,d2,d2min,fc,xc,xs)
+#endif
+  for (m=0;m<ntot;m++) {
+    if (icm[m] == -1)
+      continue;
+    iv[0] = (int) (m % nc[0]);
+    iv[1] = (int) ((m / nc[0]) % nc[1]);
+    iv[2] = (int) (m / ((long int) nc[0]*nc[1]));
+    xc[2] = grid->x0[2];
+    for (n=0;n<grid->ndim;n++)
+      xc[n] = grid->x0[n] + (iv[n] + 0.5)*h0;
+    for (n=0;n<NDIM;n++) {
+      lo[n] = MAX(iv[n]-nb-1,0);
+      hi[n] = MIN(iv[n]+nb+1,nc[n]-1);
+    }
+    d2min = -1.;                  /* closest interface point of the cut cells */
+    for (jv[2]=lo[2];jv[2]<=hi[2];jv[2]++)
+      for (jv[1]=lo[1];jv[1]<=hi[1];jv[1]++)
+	for (jv[0]=lo[0];jv[0]<=hi[0];jv[0]++) {
+	  c = icm[jv[0] + nc[0]*(jv[1] + (long int) nc[1]*jv[2])];
+	  if (c < 0)
+	    continue;
+	  for (p=pl.ipt[c];p<pl.ipt[c+1];p++) {
+	    d2 = Sqd3(xc,(pl.xpt+NDIM*p));
+	    if (d2min < 0. || d2 < d2min) {
+	      d2min = d2;
+	      for (n=0;n<NDIM;n++)
+		xs[n] = pl.xpt[NDIM*p+n];
+	    }
+	  }
+	}
+    if (d2min < 0.)                        /* no interface point nearby */
+      continue;
+    fc = impl_func(userdata,xc);
+    sd[m] = MIN(vofi_get_sdf_cell(impl_func,userdata,xc,xs,h0,grid->ndim),dmax);
+    if (fc < 0.)
+      sd[m] = -sd[m];
+  }
+
+  free(icm);
+  vofi_Free_plic(&pl);
+
+  return vol;
+}
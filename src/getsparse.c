@@ -0,0 +1,224 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file getsparse.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli, 
+ *          Philip Yecko and Stephane Zaleski 
+ * @date  12 November 2015
+ * @brief Driver to compute the volume fraction in all cells of a grid in 
+ *        a sparse format, with run-length encoded full/empty cells, and 
+ *        its expansion into a dense array.
+ */
+
+#include <string.h>
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * make room for n more runs and n more cut cells in the sparse structure,   *
+ * by doubling the size of its arrays                                         *
+ * INPUT: sparse structure sp, number of new entries n                        *
+ * OUTPUT: ist: success/failure (0/-1)                                        *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_sparse_room(vofi_sparse *sp,long int n)
+{
+  long int m;
+  void *p;
+
+  if (sp->nrun + n > sp->mrun) {
+    m = MAX(2*sp->mrun,sp->nrun + n);
+    if ((p = realloc(sp->rlen,m*sizeof(int))) == NULL)
+      return -1;
+    sp->rlen = (int *) p;
+    if ((p = realloc(sp->rval,m*sizeof(signed char))) == NULL)
+      return -1;
+    sp->rval = (signed char *) p;
+    sp->mrun = m;
+  }
+  if (sp->ncut + n > sp->mcut) {
+    m = MAX(2*sp->mcut,sp->ncut + n);
+    if ((p = realloc(sp->icut,m*sizeof(long int))) == NULL)
+      return -1;
+    sp->icut = (long int *) p;
+    if ((p = realloc(sp->ccut,m*sizeof(vofi_real))) == NULL)
+      return -1;
+    sp->ccut = (vofi_real *) p;
+    sp->mcut = m;
+  }
+
+  return 0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * append a grid row to the sparse structure: the cells with cc exactly 0 or  *
+ * 1 are grouped in runs of equal values, each cut cell is a run of value -1  *
+ * and its index and value are added to the list of cut cells                 *
+ * INPUT: sparse structure sp, volume fraction values of the row ccr, number  *
+ * of cells of the row nx, index of its first cell m0                         *
+ * OUTPUT: ist: success/failure (0/-1)                                        *
+ * -------------------------------------------------------------------------- */
+
+int vofi_get_sparse_row(vofi_sparse *sp,vofi_creal ccr[],vofi_cint nx,long int m0)
+{
+  int i,iv,ivp;
+
+  if (vofi_get_sparse_room(sp,nx) != 0)
+    return -1;
+
+  ivp = -2;
+  for (i=0;i<nx;i++) {
+    if (ccr[i] == 0.)
+      iv = 0;
+    else if (ccr[i] == 1.)
+      iv = 1;
+    else {
+      iv = -1;
+      sp->icut[sp->ncut] = m0 + i;
+      sp->ccut[sp->ncut] = ccr[i];
+      sp->ncut++;
+    }
+    if (iv == ivp && iv >= 0)
+      sp->rlen[sp->nrun-1]++;
+    else {
+      sp->rlen[sp->nrun] = 1;
+      sp->rval[sp->nrun] = (signed char) iv;
+      sp->nrun++;
+    }
+    ivp = iv;
+  }
+
+  return 0;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction in all cells of a grid in a sparse   *
+ * format: the grid is processed in slabs of nblk cells along the last        *
+ * direction with the hierarchical classification of vofi_Get_cc_grid, then   *
+ * each row of cells along x is run-length encoded, the dense array is never  *
+ * allocated                                                                  *
+ * INPUT: pointer to the implicit function, grid structure, characteristic   *
+ * function value fh                                                          *
+ * OUTPUT: sp: sparse structure (to be released with vofi_Free_sparse), vol:  *
+ * total volume of the reference phase (-1 if out of memory)                  *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_sparse(integrand impl_func,void *userdata,const vofi_grid *grid,vofi_creal fh,
+                             vofi_sparse *sp)
+{
+  int n,ld,nd,nz,nk,kp,jr,ist;
+  long int np,nr,r0;
+  vofi_real vol,*cc;
+
+  memset(sp,0,sizeof(vofi_sparse));
+  for (n=0;n<NDIM;n++)
+    sp->nc[n] = (n < grid->ndim) ? grid->nc[n] : 1;
+  sp->ndim = grid->ndim;
+
+  ld = grid->ndim - 1;                      /* slabs along the last direction */
+  nd = grid->nc[ld];
+  nz = MAX(grid->nblk,1);
+  np = 1;
+  for (n=0;n<ld;n++)
+    np *= grid->nc[n];
+  nr = (long int) sp->nc[1]*sp->nc[2];                     /* number of rows */
+
+  cc = (vofi_real *) malloc(np*MIN(nz,nd)*sizeof(vofi_real));
+  sp->irow = (long int *) malloc((nr+1)*sizeof(long int));
+  ist = (cc == NULL || sp->irow == NULL) ? -1 : 0;
+
+  vol = 0.;
+  for (kp=0;kp<nd && ist==0;kp+=nz) {
+    nk = MIN(nz,nd-kp);
+    vol += vofi_get_cc_slab(impl_func,userdata,grid,fh,kp,nk,NULL,cc);
+    r0 = np*kp/sp->nc[0];                    /* first row of the slab */
+    for (jr=0;jr<np*nk/sp->nc[0] && ist==0;jr++) {
+      sp->irow[r0+jr] = sp->nrun;
+      ist = vofi_get_sparse_row(sp,cc+(long int)jr*sp->nc[0],sp->nc[0],(r0+jr)*sp->nc[0]);
+    }
+  }
+  free(cc);
+
+  if (ist != 0) {
+    fprintf(stderr,"Out of memory in vofi_Get_cc_sparse \n");
+    vofi_Free_sparse(sp);
+    return -1.;
+  }
+  sp->irow[nr] = sp->nrun;
+
+  return vol;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * expand the sparse format into a dense array of volume fraction values,     *
+ * cc[i + nc[0]*(j + nc[1]*k)]                                                *
+ * INPUT: sparse structure sp                                                 *
+ * OUTPUT: cc: volume fraction values                                         *
+ * -------------------------------------------------------------------------- */
+
+void vofi_Get_dense(const vofi_sparse *sp,vofi_real cc[])
+{
+  int i,l;
+  long int n,m,ic;
+  vofi_real v;
+
+  m = 0;
+  ic = 0;
+  for (n=0;n<sp->nrun;n++) {
+    l = sp->rlen[n];
+    if (sp->rval[n] < 0)
+      cc[m++] = sp->ccut[ic++];
+    else {
+      v = (vofi_real) sp->rval[n];
+      for (i=0;i<l;i++)
+	cc[m+i] = v;
+      m += l;
+    }
+  }
+
+  return;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * release the arrays of the sparse structure                                 *
+ * INPUT: sparse structure sp                                                 *
+ * OUTPUT: sp: empty sparse structure                                         *
+ * -------------------------------------------------------------------------- */
+
+void vofi_Free_sparse(vofi_sparse *sp)
+{
+  free(sp->irow);
+  free(sp->rlen);
+  free(sp->rval);
+  free(sp->icut);
+  free(sp->ccut);
+  sp->irow = NULL;
+  sp->rlen = NULL;
+  sp->rval = NULL;
+  sp->icut = NULL;
+  sp->ccut = NULL;
+  sp->nrun = sp->mrun = 0;
+  sp->ncut = sp->mcut = 0;
+
+  return;
+}
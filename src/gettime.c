@@ -0,0 +1,108 @@
+/****************************************************************************
+ * Copyright (C) 2015 by Simone Bnà(a), Sandro Manservisi(a),               *
+ * Ruben Scardovelli(a), Philip Yecko(b) and Stephane Zaleski(c,d)          *
+ * (a) DIN–Lab. di Montecuccolino, Università di Bologna,                   *
+ *     Via dei Colli 16, 40136 Bologna, Italy                               *
+ * (b) Physics Department, Cooper Union, New York, NY, USA                  *
+ * (c) Sorbonne Universités, UPMC Univ Paris 06, UMR 7190,                  *
+ *     Institut Jean Le Rond d’Alembert, F-75005, Paris, France             *
+ * (d) CNRS, UMR 7190, Institut Jean Le Rond d’Alembert, F-75005,           *
+ *     Paris, France                                                        *
+ *                                                                          *
+ * You should have received a copy of the CPC license along with Vofi.      *
+ * If not, see http://cpc.cs.qub.ac.uk/licence/licence.html.                *
+ *                                                                          *
+ * e-mail: ruben.scardovelli@unibo.it                                       *
+ *                                                                          *
+ ****************************************************************************/
+
+/**
+ * @file gettime.c
+ * @authors Simone Bnà, Sandro Manservisi, Ruben Scardovelli,
+ *          Philip Yecko and Stephane Zaleski
+ * @date  12 November 2015
+ * @brief It contains the driver that computes the volume fraction of a cell
+ *        averaged over a time step, for an implicit function of space and
+ *        time.
+ */
+
+#include "vofi_stddecl.h"
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * implicit function of space and time at the time of the data, so that the   *
+ * routines of a single time can be used                                      *
+ * INPUT: data ptm: function of space and time, its data and the time,        *
+ * point xy                                                                   *
+ * OUTPUT: f: value of the implicit function                                  *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_time_f(void *ptm,vofi_creal xy[])
+{
+  tim_data *ptd = (tim_data *) ptm;
+
+  return ptd->impl_func(ptd->userdata,xy,ptd->t);
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * Driver to compute the volume fraction of a cell averaged over the time     *
+ * step [t0,t1], e.g. for the initialization of fluxes and source terms,      *
+ * with npt Gauss-Legendre nodes in time; with the Lipschitz bounds in space  *
+ * and time, opts->lip and opts->lipt, the cell is certified full or empty    *
+ * during the whole step if |f(xc,tc)| > lip*r + lipt*(t1 - t0)/2, where xc   *
+ * is the cell center, r its half diagonal and tc the middle of the step,     *
+ * then the time nodes are skipped; else each time node is classified and     *
+ * integrated as in vofi_Get_cc_opt, with the certified test if lip alone is  *
+ * given, else with the local grid test at each node; the interval extension  *
+ * opts->int_func is a function of space only, hence it is not used           *
+ * INPUT: pointer to the implicit function of space and time, starting point  *
+ * x0, grid spacing h0, characteristic function value fh, space dimension     *
+ * ndim0, time step [t0,t1], number of nodes in time npt, optional settings   *
+ * opts (may be NULL)                                                         *
+ * OUTPUT: cc: volume fraction value averaged over the time step              *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_Get_cc_time(time_integrand impl_func,void *userdata,vofi_creal x0[],
+                           vofi_creal h0,vofi_creal fh,vofi_cint ndim0,vofi_creal t0,
+                           vofi_creal t1,vofi_cint npt,const vofi_opts *opts)
+{
+  int i,n,icc;
+  vofi_real xc[NDIM];
+  vofi_real fc,rd,cc;
+  vofi_opts opt;
+  tim_data tdt;
+  rul_data rul;
+
+  tdt.impl_func = impl_func;
+  tdt.userdata = userdata;
+  tdt.t = 0.5*(t0 + t1);
+  if (opts != NULL && opts->lip > 0. && opts->lipt > 0.) {  /* space-time box */
+    xc[2] = 0.;
+    rd = 0.;
+    for (i=0;i<ndim0;i++) {
+      xc[i] = x0[i] + 0.5*h0;
+      rd += Sq(h0);
+    }
+    rd = 0.5*sqrt(rd);
+    fc = impl_func(userdata,xc,tdt.t);
+    if (fabs(fc) > opts->lip*rd + 0.5*opts->lipt*fabs(t1 - t0))
+      return (fc < 0.) ? 1. : 0.;
+  }
+
+  if (opts != NULL) {                /* int_func has not the time argument */
+    opt = *opts;
+    opt.int_func = NULL;
+    opts = &opt;
+  }
+
+  /* Gauss-Legendre nodes and weights in [-1,1] of the quadrature rules */
+  vofi_init_rule(&rul,NULL,npt,ndim0);
+  cc = 0.;
+  for (n=0;n<rul.npr;n++) {
+    tdt.t = 0.5*(t0 + t1) + 0.5*(t1 - t0)*rul.xpr[n];
+    cc += 0.5*rul.wpr[n]*vofi_get_cc_cell(vofi_get_time_f,&tdt,x0,h0,fh,ndim0,opts,NULL,&icc);
+  }
+
+  return cc;
+}
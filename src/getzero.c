@@ -31,7 +31,9 @@
  * DESCRIPTION:                                                               *
  * compute the zero in a given segment of length s0, the zero is strictly     *
  * bounded, i.e. f(0)*f(s0) < 0                                               *
- * METHOD: standard hybrid method with a combination of secant and bisection  *
+ * METHOD: standard hybrid method with a combination of secant and bisection, *
+ * if it stalls, e.g. close to a double zero or at the noise level of f, the  *
+ * bracket is bisected down to the tolerance                                  *
  * INPUT: pointer to the implicit function, function value at the             *
  * endpoints fe, starting point x0, direction dir, segment length s0, sign    *
  * attribute f_sign                                                           *
@@ -107,12 +109,22 @@ vofi_real vofi_get_segment_zero(integrand impl_func,void *userdata,vofi_creal fe
     }
   }
 
-  if (!not_conv)                                /* segment length where f < 0 */
-    sz = (1-iss)*ss + iss*(s0-ss);
-  else {                                               /* too many iterations */
-    fprintf(stderr,"Root finding: too many iterations! \n");
-    sz = -1.;
+  while (not_conv) {                   /* stalled: bisection on the bracket */
+    ss = 0.5*(sl + sr);
+    if (fabs(sr - sl) < EPS_R)
+      not_conv = 0;
+    else {
+      for (i=0; i<NDIM; i++)
+        xs[i] = x0[i] + ss*dir[i];
+      fs = f_sign*impl_func(userdata,xs);
+      if (fs < 0.0)
+	sl = ss;
+      else
+	sr = ss;
+    }
   }
 
+  sz = (1-iss)*ss + iss*(s0-ss);                /* segment length where f < 0 */
+
   return sz;
 }
@@ -35,18 +35,20 @@
  * INPUT: pointer to the implicit function, starting point x0, internal       *
  * limits of integration int_lim_intg, primary and secondary directions pdir  *
  * and  sdir, grid spacing h0, number of internal subdivisions nintsub,       *
- * tentative number of internal integration points nintpt                     *
+ * tentative number of internal integration points nintpt, quadrature rules  *
+ * prl (may be NULL): if given, the nodes along the heights of the interface  *
+ * and of the full rectangles, and the interface points, are added to them   *
  * OUTPUT: area: normalized value of the cut area or 2D volume fraction       *
  * -------------------------------------------------------------------------- */
 
 double vofi_get_area(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal int_lim_intg[],
                      vofi_creal pdir[],vofi_creal sdir[],vofi_creal h0,vofi_cint nintsub,vofi_cint
-                     nintpt)
+                     nintpt,rul_data *prl)
 {
   int i,ns,k,npt,cut_rect;
   vofi_cint true_sign = 1;
-  vofi_real x1[NDIM],x20[NDIM],x21[NDIM],fe[NEND];
-  vofi_real area,ds,cs,xis,ht,GL_1D;
+  vofi_real x1[NDIM],x20[NDIM],x21[NDIM],xs[NDIM],fe[NEND];
+  vofi_real area,ds,cs,xis,ht,p0,GL_1D;
   vofi_creal *ptinw, *ptinx;
 
   /* GRAPHICS I */
@@ -71,8 +73,11 @@ double vofi_get_area(integrand impl_func,void *userdata,vofi_creal x0[],vofi_cre
       cut_rect = 1;        
     
     if (!cut_rect) {                    /* no interface: full/empty rectangle */
-      if (fe[0] < 0.0)
+      if (fe[0] < 0.0) {
 	area += ds*h0; 
+	if (prl != NULL)
+	  vofi_add_rule_rect(prl,x0,pdir,sdir,int_lim_intg[ns-1],int_lim_intg[ns],h0);
+      }
       /* DEBUG 2 */
 
     }
@@ -132,6 +137,15 @@ double vofi_get_area(integrand impl_func,void *userdata,vofi_creal x0[],vofi_cre
 	}
 	/* DEBUG 4 */
 
+	if (prl != NULL && ht > 0.) {   /* nodes of the segment where f < 0 */
+	  p0 = (fe[0] < 0.) ? 0. : h0 - ht;
+	  vofi_add_rule_column(prl,x20,pdir,p0,ht,0.5*ds*(*ptinw));
+	  if (fe[0]*fe[1] < 0.) {
+	    for (i=0;i<NDIM;i++)
+	      xs[i] = x20[i] + pdir[i]*((fe[0] < 0.) ? ht : p0);
+	    vofi_add_rule_point(impl_func,userdata,prl,xs,pdir,h0,0.5*ds*(*ptinw));
+	  }
+	}
 	GL_1D += (*ptinw)*ht;
 	ptinx++;
 	ptinw++;
@@ -156,13 +170,16 @@ double vofi_get_area(integrand impl_func,void *userdata,vofi_creal x0[],vofi_cre
  * limits of integration ext_lim_intg, primary, secondary and tertiary        *
  * directions pdir, sdir and tdir, grid spacing h0, number of external        *
  * subdivisions nextsub, tentative number of internal integration points      *
- * nintpt                                                                     *  
+ * nintpt, warm start iwarm of the internal limits (1/0): the single          *
+ * intersection of a side is searched near those of the previous planes,      *
+ * quadrature rules prl (may be NULL) also of the full hexahedra              *
  * OUTPUT: vol: normalized value of the cut volume or 3D volume fraction      *
+ * (-1: no room for the internal limits of an external node)                  *
  * -------------------------------------------------------------------------- */
 
 double vofi_get_volume(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal ext_lim_intg[],
 		       vofi_creal pdir[],vofi_creal sdir[],vofi_creal tdir[],vofi_creal h0,
-		       vofi_cint nextsub,vofi_cint nintpt)
+		       vofi_cint nextsub,vofi_cint nintpt,vofi_cint iwarm,rul_data *prl)
 {
   int i,ns,k,nexpt,cut_hexa,f_iat,nintsub;
   vofi_cint stdir=2,max_iter=50;
@@ -170,6 +187,7 @@ double vofi_get_volume(integrand impl_func,void *userdata,vofi_creal x0[],vofi_c
   vofi_real vol,ds,cs,xis,f1,f2,area_n,GL_1D;
   vofi_creal *ptexw, *ptexx;
   min_data xfsa;
+  lim_data xlim;
   
   vol = 0.;
   
@@ -219,8 +237,17 @@ double vofi_get_volume(integrand impl_func,void *userdata,vofi_creal x0[],vofi_c
     }
 
     if (!cut_hexa) {                   /* no interface: full/empty hexahedron */ 
-      if (f1 < 0.)
+      if (f1 < 0.) {
 	vol += ds;
+	if (prl != NULL) 
+	  for (k=0;k<prl->npr;k++) {
+	    xis = cs + 0.5*ds*prl->xpr[k];
+	    for (i=0;i<NDIM;i++) 
+	      x1[i] = x0[i] + tdir[i]*xis;
+	    prl->wext = 0.5*ds*prl->wpr[k];
+	    vofi_add_rule_rect(prl,x1,pdir,sdir,0.,h0,h0);
+	  }
+      }
         /* DEBUG 2 */
 
     }
@@ -246,16 +273,25 @@ double vofi_get_volume(integrand impl_func,void *userdata,vofi_creal x0[],vofi_c
         ptexw = wgt20;
       }
       GL_1D = 0.;
+      xlim.nz[0] = xlim.nz[1] = 0;
       /* DEBUG 3 */
 
       for (k=0;k<nexpt;k++) {
 	xis = cs + 0.5*ds*(*ptexx);
 	for (i=0;i<NDIM;i++) 
 	  x1[i] = x0[i] + tdir[i]*xis;
-	nintsub = vofi_get_limits(impl_func,userdata,x1,int_lim_intg,pdir,sdir,tdir,h0,
-                                  stdir);
+	if (iwarm)
+	  nintsub = vofi_get_limits_inner(impl_func,userdata,x1,int_lim_intg,pdir,sdir,h0,
+                                          xis,&xlim);
+	else
+	  nintsub = vofi_get_limits(impl_func,userdata,x1,int_lim_intg,pdir,sdir,tdir,h0,
+                                    stdir,NULL);
+	if (nintsub < 0)                   /* no room for the internal limits */
+	  return -1.;
+	if (prl != NULL)
+	  prl->wext = 0.5*ds*(*ptexw);
 	area_n = vofi_get_area(impl_func,userdata,x1,int_lim_intg,pdir,sdir,h0,nintsub,
-                               nintpt);
+                               nintpt,prl);
 	/* DEBUG 4 */
 
  	GL_1D += (*ptexw)*area_n;
@@ -270,3 +306,218 @@ double vofi_get_volume(integrand impl_func,void *userdata,vofi_creal x0[],vofi_c
 
   return vol;
 }                       
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_get_area, in the reference triangle {p, s >= 0, p + s <= h0}  *
+ * of an affine map: the column at s along pdir has length h0 - s             *
+ * INPUT: pointer to the implicit function, starting point x0, internal       *
+ * limits of integration int_lim_intg of vofi_get_limits_simplex, primary and *
+ * secondary directions pdir and sdir, side of the triangle h0, number of     *
+ * internal subdivisions nintsub, tentative number of internal integration    *
+ * points nintpt                                                              *
+ * OUTPUT: area: cut area normalized with the area of the triangle            *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_area_simplex(integrand impl_func,void *userdata,vofi_creal x0[],
+                                vofi_creal int_lim_intg[],vofi_creal pdir[],vofi_creal sdir[],
+                                vofi_creal h0,vofi_cint nintsub,vofi_cint nintpt)
+{
+  int i,ns,k,npt;
+  vofi_cint true_sign = 1;
+  vofi_real x20[NDIM],x21[NDIM],fe[NEND];
+  vofi_real area,ds,cs,xis,hc,ht,GL_1D;
+  vofi_creal *ptinw, *ptinx;
+
+  area = 0.;
+  for (ns=1;ns<=nintsub;ns++) {                   /* loop over the trapezoids */
+    ds = int_lim_intg[ns] - int_lim_intg[ns-1];
+    cs = 0.5*(int_lim_intg[ns] + int_lim_intg[ns-1]);
+    hc = h0 - cs;
+    for (i=0;i<NDIM;i++) {
+      x20[i] = x0[i] + sdir[i]*cs;
+      x21[i] = x20[i] + pdir[i]*hc;
+    }
+    fe[0] = impl_func(userdata,x20);
+    fe[1] = impl_func(userdata,x21);
+
+    if (fe[0]*fe[1] > 0.) {             /* no interface: full/empty trapezoid */
+      if (fe[0] < 0.0)
+	area += ds*hc;
+    }
+    else {                   /* cut trapezoid: internal numerical integration */
+      if (ds < 0.1*h0) 
+	npt = 4;
+      else if (ds < 0.2*h0)
+	npt = 8;
+      else if (ds < 0.4*h0)
+	npt = MIN(nintpt,12);
+      else if (ds < 0.6*h0) 
+	npt = MIN(nintpt,16);
+      else
+	npt = MIN(nintpt,20);
+
+      switch (npt) {
+      case 4:
+	ptinx = csi04;
+        ptinw = wgt04;
+        break;
+      case 8:
+	ptinx = csi08;
+        ptinw = wgt08;
+        break;
+      case 12:
+	ptinx = csi12;
+	ptinw = wgt12;
+        break;
+      case 16:
+	ptinx = csi16;
+	ptinw = wgt16;
+	break;
+      default:
+	ptinx = csi20;
+	ptinw = wgt20;
+	break;
+      }
+
+      GL_1D = 0.;
+      for (k=0;k<npt;k++) {
+	xis = cs + 0.5*ds*(*ptinx);
+	hc = h0 - xis;
+	for (i=0;i<NDIM;i++) {
+	  x20[i] = x0[i] + sdir[i]*xis;
+	  x21[i] = x20[i] + pdir[i]*hc;
+	}
+	fe[0] = impl_func(userdata,x20);
+	fe[1] = impl_func(userdata,x21);
+	if (fe[0]*fe[1] < 0.)
+	  ht = vofi_get_segment_zero(impl_func,userdata,fe,x20,pdir,hc,true_sign);
+	else {                        /* weird situation with multiple zeroes */
+	  if (fe[0]+fe[1] < 0.)
+	    ht = hc;
+	  else
+	    ht = 0.;
+	}
+	GL_1D += (*ptinw)*ht;
+	ptinx++;
+	ptinw++;
+      }
+      area += 0.5*ds*GL_1D;
+    }
+  }
+
+  area = area/(0.5*h0*h0);                           /* normalized area value */
+
+  return area;
+}
+
+/* -------------------------------------------------------------------------- *
+ * DESCRIPTION:                                                               *
+ * same as vofi_get_volume, in the reference tetrahedron {p, s, t >= 0,       *
+ * p + s + t <= h0} of an affine map: the plane at t is the triangle of side  *
+ * h0 - t, integrated with vofi_get_area_simplex                              *
+ * INPUT: pointer to the implicit function, starting point x0, external       *
+ * limits of integration ext_lim_intg of vofi_get_limits_simplex, primary,    *
+ * secondary and tertiary directions pdir, sdir and tdir, side of the         *
+ * tetrahedron h0, number of external subdivisions nextsub, tentative number  *
+ * of internal integration points nintpt                                      *
+ * OUTPUT: vol: cut volume normalized with the volume of the tetrahedron (-1: *
+ * no room for the internal limits of an external node)                       *
+ * -------------------------------------------------------------------------- */
+
+vofi_real vofi_get_volume_simplex(integrand impl_func,void *userdata,vofi_creal x0[],
+                                  vofi_creal ext_lim_intg[],vofi_creal pdir[],vofi_creal sdir[],
+                                  vofi_creal tdir[],vofi_creal h0,vofi_cint nextsub,
+                                  vofi_cint nintpt)
+{
+  int i,j,ns,k,nexpt,cut_tetra,f_iat,nintsub;
+  vofi_cint max_iter=50;
+  vofi_real x1[NDIM],x2[NDIM],x3[NDIM],dir[NDIM],fe[NEND],int_lim_intg[NSEG];
+  vofi_real vol,ds,cs,xis,hc,ha,hb,f1,f2,area_n,GL_1D;
+  vofi_creal *ptexw, *ptexx;
+  min_data xfsa;
+
+  vol = 0.;
+  for (ns=1;ns<=nextsub;ns++) {                 /* loop over the frusta */
+    ds = ext_lim_intg[ns] - ext_lim_intg[ns-1];
+    cs = 0.5*(ext_lim_intg[ns] + ext_lim_intg[ns-1]);
+    hc = h0 - cs;
+    cut_tetra = 0;
+    for (i=0;i<NDIM;i++) {
+      x1[i] = x0[i] + tdir[i]*cs;
+      x2[i] = x1[i] + pdir[i]*hc;
+      x3[i] = x1[i] + sdir[i]*hc;
+    }
+    f1 = impl_func(userdata,x1);
+    f2 = impl_func(userdata,x2);
+    if (f1*f2 <= 0.)
+      cut_tetra = 1;
+    for (j=0;j<2 && !cut_tetra;j++) {    /* check bottom side and hypotenuse */
+      fe[0] = (j == 0) ? f1 : f2;
+      fe[1] = impl_func(userdata,x3);
+      if (fe[0]*fe[1] <= 0.)
+	cut_tetra = 1;
+      else {
+	for (i=0;i<NDIM;i++)
+	  dir[i] = sdir[i] - j*pdir[i];
+	f_iat = vofi_check_side_consistency(impl_func,userdata,fe,(j == 0) ? x1 : x2,dir,hc);
+	if (f_iat != 0) {
+	  xfsa = vofi_get_segment_min(impl_func,userdata,fe,(j == 0) ? x1 : x2,dir,hc,f_iat,
+                                      max_iter);
+	  cut_tetra = xfsa.iat;
+	}
+      }
+    }
+
+    if (!cut_tetra) {                        /* no interface: full/empty frustum */
+      if (f1 < 0.) {
+	ha = h0 - ext_lim_intg[ns-1];
+	hb = h0 - ext_lim_intg[ns];
+	vol += (ha*ha*ha - hb*hb*hb)/3.;
+      }
+    }
+    else {                  /* cut frustum: external numerical integration */
+      if (ds < 0.1*h0) {
+	nexpt = 8;
+	ptexx = csi08;
+        ptexw = wgt08;
+      }
+      else if (ds < 0.3*h0) {
+	nexpt = 12;
+	ptexx = csi12;
+        ptexw = wgt12;
+      }
+      else if (ds < 0.5*h0) {
+	nexpt = 16;
+	ptexx = csi16;
+        ptexw = wgt16;
+      }
+      else {
+	nexpt = 20;
+	ptexx = csi20;
+        ptexw = wgt20;
+      }
+      GL_1D = 0.;
+      for (k=0;k<nexpt;k++) {
+	xis = cs + 0.5*ds*(*ptexx);
+	hc = h0 - xis;
+	for (i=0;i<NDIM;i++)
+	  x1[i] = x0[i] + tdir[i]*xis;
+	nintsub = vofi_get_limits_simplex(impl_func,userdata,x1,int_lim_intg,pdir,sdir,tdir,hc,
+                                          2);
+	if (nintsub < 0)                   /* no room for the internal limits */
+	  return -1.;
+	area_n = vofi_get_area_simplex(impl_func,userdata,x1,int_lim_intg,pdir,sdir,hc,nintsub,
+                                       nintpt);
+	GL_1D += (*ptexw)*area_n*hc*hc;
+	ptexx++;
+	ptexw++;
+      }
+      vol += 0.5*ds*GL_1D;
+    }
+  }
+
+  vol = vol/(h0*h0*h0/3.);                         /* normalized volume value */
+
+  return vol;
+}
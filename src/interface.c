@@ -61,3 +61,23 @@ vofi_real EXPORT(vofi_get_cc)(integrand impl_func,void *userdata,vofi_creal x0[]
 
   return CC;
 }
+
+/* ------------------------------------------------------------------- *
+ * DESCRIPTION:                                                        *
+ * FORTRAN to C interface for the function vofi_Get_cc_opt with the   *
+ * Lipschitz bound lip of the implicit function                        *
+ * INPUT and OUTPUT: see vofi_Get_cc_opt                               *
+ * ------------------------------------------------------------------- */
+
+vofi_real EXPORT(vofi_get_cc_lip)(integrand impl_func,void *userdata,vofi_creal x0[],vofi_creal *H0,vofi_creal *Fh,vofi_cint *Ndim0,vofi_creal *Lip)
+{
+  vofi_creal h0= *H0, fh = *Fh;
+  vofi_cint ndim0 = *Ndim0;
+  vofi_opts opts = {0};
+  vofi_real CC;
+  
+  opts.lip = *Lip;
+  CC = vofi_Get_cc_opt(impl_func,userdata,x0,h0,fh,ndim0,&opts);
+
+  return CC;
+}